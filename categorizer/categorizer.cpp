@@ -5,40 +5,84 @@
  * @date 25.05.2020
 */
 
+#include <iostream>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif
+#include <dlib/dnn.h>
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
 #include "categorizer.h"
 
+struct categorizer_t::net_t {
+    using multiLabelNet_t = dlib::loss_multiclass_log<
+            dlib::fc<categories,
+                    dlib::input<dlib::matrix<float>>
+            >>;
+
+    multiLabelNet_t multiLabelNet;
+
+    // the network keeps the state of its forward pass, a copy is evaluated, so threads share nothing mutable
+    [[nodiscard]] categories_t classify(const float *_vector, std::size_t _size) const {
+        auto net = multiLabelNet;
+        std::vector<dlib::matrix<float>> samples(1);
+        samples[0].set_size(1, static_cast<long>(_size));
+        for (std::size_t j = 0; j < _size; ++j) {
+            samples[0](j) = _vector[j];
+        }
+        return static_cast<categories_t>(net(samples)[0]);
+    }
+};
+
 categorizer_t::categorizer_t(const std::string &_categoryModelFileName) {
-    m_langMultiLabelNet = std::make_unique<multiLabelNet_t>();
-    dlib::deserialize(_categoryModelFileName) >> *m_langMultiLabelNet;
+    auto net = std::make_shared<net_t>();
+    dlib::deserialize(_categoryModelFileName) >> net->multiLabelNet;
+    m_layer = linearLayer_t::fc(dlib::layer<1>(net->multiLabelNet).layer_details());
+    if (m_layer.outputs() != categories) {
+        throw std::runtime_error("categorizer_t: wrong number of model outputs");
+    }
+    m_net = std::move(net);
 }
 
 categorizer_t::~categorizer_t() = default;
 
-void categorizer_t::operator()(const std::vector<std::vector<float>> &_vectors,
-                               std::size_t _startFrom, std::size_t _stopAt,
-                               std::vector<categories_t> &_result) noexcept {
+void categorizer_t::operator()(const matrix_t &_vectors,
+                              std::size_t _startFrom, std::size_t _stopAt,
+                              std::vector<categories_t> &_result) const noexcept {
     if (_vectors.empty()) {
         return;
     }
 
     try {
-        dlib::matrix<float> matrix;
-        auto vSize = _vectors.begin()->size();
-        matrix.set_size(1, vSize);
-        std::vector<dlib::matrix<float>> samples(_stopAt - _startFrom, matrix);
-        std::size_t pos = 0;
+        _result.resize(_stopAt - _startFrom);
         for (auto i = _startFrom; i < _stopAt; ++i) {
-            for (std::size_t j = 0; j < vSize; ++j) {
-                samples[pos](j) = _vectors[i][j];
-            }
-            pos++;
+            _result[i - _startFrom] = classify(_vectors.row(i));
         }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+    }
+}
 
-        auto prediction = (*m_langMultiLabelNet)(samples);
-        auto rSize = prediction.size();
-        _result.resize(rSize);
-        for (std::size_t i = 0; i < rSize; ++i) {
-            _result[i] = static_cast<categories_t>(prediction[i]);
+void categorizer_t::operator()(const matrix_t &_vectors,
+                              const std::vector<uint32_t> &_rows,
+                              std::size_t _startFrom, std::size_t _stopAt,
+                              std::vector<categories_t> &_result) const noexcept {
+    if (_startFrom >= _stopAt) {
+        return;
+    }
+
+    try {
+        _result.resize(_stopAt - _startFrom);
+        for (auto i = _startFrom; i < _stopAt; ++i) {
+            _result[i - _startFrom] = classify(_vectors.row(_rows[i]));
         }
     } catch (const std::exception &_e) {
         std::cerr << _e.what() << std::endl;
@@ -46,3 +90,27 @@ void categorizer_t::operator()(const std::vector<std::vector<float>> &_vectors,
         std::cerr << "unknown error" << std::endl;
     }
 }
+
+heads_t::categoryReference_t categorizer_t::reference() const {
+    return [net = m_net, size = m_layer.inputs()](const float *_vector) {
+        return net->classify(_vector, size);
+    };
+}
+
+categories_t categorizer_t::classify(const float *_vector) const {
+    float logits[categories];
+    m_layer(_vector, logits);
+
+    std::size_t category = 0;
+    for (std::size_t i = 1; i < categories; ++i) {
+        if (logits[i] > logits[category]) {
+            category = i;
+        }
+    }
+    for (std::size_t i = 0; i < categories; ++i) {
+        if ((i != category) && (logits[category] - logits[i] < heads_t::tieMargin)) {
+            return m_net->classify(_vector, m_layer.inputs());
+        }
+    }
+    return static_cast<categories_t>(category);
+}
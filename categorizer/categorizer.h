@@ -8,38 +8,46 @@
 #ifndef TGNEWS_CATEGORIZER_H
 #define TGNEWS_CATEGORIZER_H
 
-#include <vector>
+#include <cstdint>
 #include <memory>
-
-#if defined(__clang__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
-#pragma clang diagnostic ignored "-Wunused-parameter"
-#pragma clang diagnostic ignored "-Wextra-semi"
-#endif
-#include <dlib/dnn.h>
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif
+#include <string>
+#include <vector>
 
 #include "types.h"
+#include "inference/linearLayer.h"
+#include "inference/heads.h"
 
+// The dlib multiclass classifier is a single fc layer, its weights are extracted at load and evaluated by
+// linearLayer_t, the category is the first maximal logit as of the dlib network: if the two top logits are within
+// heads_t::tieMargin, the category is decided by the network itself.
 class categorizer_t {
 public:
     explicit categorizer_t(const std::string &_categoryModelFileName);
     ~categorizer_t();
 
-    void operator()(const std::vector<std::vector<float>> &_vectors,
+    // classifies rows [_startFrom, _stopAt) of _vectors
+    void operator()(const matrix_t &_vectors,
+                    std::size_t _startFrom, std::size_t _stopAt,
+                    std::vector<categories_t> &_result) const noexcept;
+    // classifies rows _rows[i] of _vectors, i = [_startFrom, _stopAt)
+    void operator()(const matrix_t &_vectors,
+                    const std::vector<uint32_t> &_rows,
                     std::size_t _startFrom, std::size_t _stopAt,
-                    std::vector<categories_t> &_result) noexcept;
+                    std::vector<categories_t> &_result) const noexcept;
+
+    [[nodiscard]] const linearLayer_t &layer() const noexcept {return m_layer;}
+    // decision of the dlib network, shares the network and outlives the categorizer
+    [[nodiscard]] heads_t::categoryReference_t reference() const;
 
 private:
-    using multiLabelNet_t = dlib::loss_multiclass_log<
-            dlib::fc<7,
-                    dlib::input<dlib::matrix<float>>
-            >>;
+    static constexpr std::size_t categories = 7;
+
+    struct net_t;
+
+    std::shared_ptr<const net_t> m_net;
+    linearLayer_t m_layer;
 
-    std::unique_ptr<multiLabelNet_t> m_langMultiLabelNet;
+    [[nodiscard]] categories_t classify(const float *_vector) const;
 };
 
 #endif //TGNEWS_CATEGORIZER_H
@@ -14,24 +14,37 @@
 
 #include "types.h"
 #include "dataLoader/dataLoader.h"
+#include "dataLoader/gumboArena.h"
+#include "dataLoader/docCache.h"
 #include "newsCluster/newsCluster.h"
 #include "categoryCluster/categoryCluster.h"
 #include "similarityCluster/similarityCluster.h"
+#include "pipeline/pipeline.h"
 
 #include "cli.h"
 
 cli_t::cli_t(const std::vector<std::string> &_langCodes,
              const std::unordered_map<std::string, std::string> &_w2vModels,
+             const embedderSettings_t &_embedderSettings,
              const std::unordered_map<std::string, std::string> &_newsDetectionModels,
              const std::unordered_map<std::string, std::string> &_categoryDetectionModels,
              const std::unordered_map<categories_t, std::string> &_categoryNames,
-             const std::unordered_map<std::string, float> &_similarityThreshold):
+             const std::unordered_map<std::string, float> &_similarityThreshold,
+             const pipelineSettings_t &_pipelineSettings,
+             htmlParser_t _htmlParser,
+             bool _ioUring,
+             const char *_docCacheFile):
         m_langCodes(_langCodes),
         m_w2vModels(_w2vModels),
+        m_embedderSettings(_embedderSettings),
         m_newsDetectionModels(_newsDetectionModels),
         m_categoryDetectionModels(_categoryDetectionModels),
         m_categoryNames(_categoryNames),
-        m_similarityThreshold(_similarityThreshold) {
+        m_similarityThreshold(_similarityThreshold),
+        m_pipelineSettings(_pipelineSettings),
+        m_htmlParser(_htmlParser),
+        m_ioUring(_ioUring),
+        m_docCacheFile((_docCacheFile != nullptr)?_docCacheFile:"") {
 }
 
 //#include <fstream>
@@ -39,12 +52,69 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
 // init JSON document
     rapidjson::Document json;
 
-// Parsing, languages detection...
-    dataLoader_t dataLoader(_threads, m_langCodes, _path, (_cmd == cmd_t::LNG));
-//    dataLoader_t dataLoader(_threads, m_langCodes, _path);
+// Parsing, languages detection, embedding, news detecting, categorizing...
+    std::unique_ptr<pipeline_t> pipeline;
+    std::unique_ptr<dataLoader_t> dataLoader;
+    std::unique_ptr<newsCluster_t> newsCluster;
+    std::unique_ptr<categoryCluster_t> categoryCluster;
+    // the cache is used by the phased mode only
+    std::unique_ptr<docCache_t> docCache;
+    if (!m_docCacheFile.empty() && !m_pipelineSettings.enabled) {
+        std::vector<std::string> modelFiles;
+        for (const auto &m:m_w2vModels) {
+            modelFiles.emplace_back(m.second);
+#ifdef WITH_FAISS
+            modelFiles.emplace_back(m.second + ".map");
+#endif
+        }
+        auto settings = "parser:" + std::to_string(static_cast<int>(m_htmlParser));
+#ifdef WITH_FAISS
+        // fp16 decoded index vectors change embeddings
+        settings += m_embedderSettings.decodedFp16?",decoded:fp16":"";
+#endif
+        docCache = std::make_unique<docCache_t>(m_docCacheFile, docCache_t::fingerprint(modelFiles, settings));
+    }
+    if (m_pipelineSettings.enabled) {
+        pipeline = std::make_unique<pipeline_t>(_threads, _cmd, m_pipelineSettings,
+                                                m_langCodes,
+                                                m_w2vModels,
+                                                m_embedderSettings,
+                                                m_newsDetectionModels,
+                                                m_categoryDetectionModels,
+                                                m_categoryNames,
+                                                m_htmlParser,
+                                                m_ioUring,
+                                                _path);
+    } else {
+        dataLoader = std::make_unique<dataLoader_t>(_threads, m_langCodes, _path, (_cmd == cmd_t::LNG),
+                                                    m_htmlParser, m_ioUring, docCache.get());
+        if (_cmd != cmd_t::LNG) {
+// Normalizing, documents embedding, news detecting and categorizing in one pass...
+            bool categories = (_cmd == cmd_t::CTG) || (_cmd == cmd_t::THR);
+            newsCluster = std::make_unique<newsCluster_t>(_threads,
+                                                          m_w2vModels,
+                                                          m_embedderSettings,
+                                                          m_newsDetectionModels,
+                                                          categories?m_categoryDetectionModels:
+                                                          std::unordered_map<std::string, std::string>(),
+                                                          dataLoader->docTable(),
+                                                          dataLoader->langDocSet(),
+                                                          docCache.get());
+        }
+        if ((_cmd == cmd_t::CTG) || (_cmd == cmd_t::THR)) {
+// Category clustering...
+            categoryCluster = std::make_unique<categoryCluster_t>(m_categoryNames,
+                                                                  newsCluster->langVecSet(),
+                                                                  newsCluster->categories());
+        }
+    }
+    // documents are referred by ids, names are resolved here
+    const auto &docTable = pipeline?pipeline->docTable():dataLoader->docTable();
+    const auto &langDocSet = pipeline?pipeline->langDocSet():dataLoader->langDocSet();
+
     if (_cmd == cmd_t::LNG) {
         json.SetArray();
-        for (const auto &ld:dataLoader.langDocSet()) {
+        for (const auto &ld:langDocSet) {
 /*
             // get file names
             std::ofstream ofs(ld.first);
@@ -61,8 +131,8 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
 /*
             // get soure data
             std::ofstream ofs(ld.first);
-            for (const auto &a:ld.second) {
-                auto txt = a.second.title + ". " + a.second.text;
+            for (auto id:ld.second) {
+                auto txt = docTable.documents[id].title + ". " + docTable.documents[id].text;
                 std::size_t pos = std::string::npos;
                 while (true) {
                     pos = txt.find('\n', pos);
@@ -76,32 +146,25 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
             }
 */
             rapidjson::Value jsonArticleArray(rapidjson::kArrayType);
-            for (const auto &a:ld.second) {
+            for (auto id:ld.second) {
+                const auto &name = docTable.documents[id].name;
                 rapidjson::Value jsonArticle;
-                jsonArticle.SetString(a.second.name.c_str(), a.second.name.length(), json.GetAllocator());
+                jsonArticle.SetString(name.c_str(), name.length(), json.GetAllocator());
                 jsonArticleArray.PushBack(jsonArticle, json.GetAllocator());
             }
             jsonLangObject.AddMember("articles", jsonArticleArray, json.GetAllocator());
             json.PushBack(jsonLangObject, json.GetAllocator());
         }
     } else { // it's not the language detection task
-// Normalizing, documents embedding, news detecting...
-        newsCluster_t newsCluster(_threads, m_w2vModels, m_newsDetectionModels, dataLoader.langDocSet());
+        const auto &langVecSet = pipeline?pipeline->langVecSet():newsCluster->langVecSet();
         if (_cmd == cmd_t::NWS) {
             json.SetObject();
             rapidjson::Value jsonArticleArray(rapidjson::kArrayType);
-            for (const auto &lv:newsCluster.langVecSet()) {
-                auto lds = dataLoader.langDocSet().find(lv.first);
-                if (lds == dataLoader.langDocSet().end()) {
-                    continue;
-                }
-                for (const auto &a:lv.second) {
-                    auto doc = lds->second.find(a.first);
-                    if (doc == lds->second.end()) {
-                        continue;
-                    }
+            for (const auto &lv:langVecSet) {
+                for (auto id:lv.second) {
+                    const auto &name = docTable.documents[id].name;
                     rapidjson::Value jsonArticle;
-                    jsonArticle.SetString(doc->second.name.c_str(), doc->second.name.length(), json.GetAllocator());
+                    jsonArticle.SetString(name.c_str(), name.length(), json.GetAllocator());
                     jsonArticleArray.PushBack(jsonArticle, json.GetAllocator());
                 }
             }
@@ -109,13 +172,9 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
         } else { // it's not the news isolation task
             json.SetArray();
 
-// Category clustering...
-            auto categoryCluster = std::make_unique<categoryCluster_t>(_threads,
-                                                                       m_categoryDetectionModels,
-                                                                       m_categoryNames,
-                                                                       newsCluster.langVecSet());
+            const auto &groupSet = pipeline?pipeline->groupSet():categoryCluster->groupSet();
             if (_cmd == cmd_t::CTG) {
-                for (const auto &cc:categoryCluster->groupSet()) {
+                for (const auto &cc:groupSet) {
                     auto c = m_categoryNames.find(cc.first);
                     if (c == m_categoryNames.end()) {
                         continue;
@@ -128,18 +187,10 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
                     jsonCategoryObject.AddMember("category", jsonCategoryName, json.GetAllocator());
 
                     rapidjson::Value jsonArticleArray(rapidjson::kArrayType);
-                    for (const auto &a:cc.second) {
-                        auto lds = dataLoader.langDocSet().find(a.second);
-                        if (lds == dataLoader.langDocSet().end()) {
-                            continue;
-                        }
-                        auto doc = lds->second.find(a.first);
-                        if (doc == lds->second.end()) {
-                            continue;
-                        }
+                    for (auto id:cc.second) {
+                        const auto &name = docTable.documents[id].name;
                         rapidjson::Value jsonArticle;
-                        jsonArticle.SetString(doc->second.name.c_str(), doc->second.name.length(),
-                                              json.GetAllocator());
+                        jsonArticle.SetString(name.c_str(), name.length(), json.GetAllocator());
                         jsonArticleArray.PushBack(jsonArticle, json.GetAllocator());
                     }
                     jsonCategoryObject.AddMember("articles", jsonArticleArray, json.GetAllocator());
@@ -149,37 +200,26 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
 // Similarity clustering...
                 similarityCluster_t similarityCluster(_threads,
                                                       m_similarityThreshold,
-                                                      newsCluster.langVecSet(),
-                                                      categoryCluster->groupSet());
+                                                      docTable,
+                                                      langVecSet,
+                                                      groupSet);
                 for (const auto &sc:similarityCluster.clusters()) {
-                    auto lds = dataLoader.langDocSet().find(sc.first[0].second);
-                    if (lds == dataLoader.langDocSet().end()) {
-                        continue;
-                    }
-                    auto doc = lds->second.find(sc.first[0].first);
-                    if (doc == lds->second.end()) {
+                    if (sc.first.empty()) {
                         continue;
                     }
+                    const auto &title = docTable.documents[sc.first[0]].title;
 
                     rapidjson::Value jsonGroupObject(rapidjson::kObjectType);
 
                     rapidjson::Value jsonCategoryName;
-                    jsonCategoryName.SetString(doc->second.title.c_str(), doc->second.title.length(), json.GetAllocator());
+                    jsonCategoryName.SetString(title.c_str(), title.length(), json.GetAllocator());
                     jsonGroupObject.AddMember("title", jsonCategoryName, json.GetAllocator());
 
                     rapidjson::Value jsonArticleArray(rapidjson::kArrayType);
-                    for (const auto &a:sc.first) {
-                        lds = dataLoader.langDocSet().find(a.second);
-                        if (lds == dataLoader.langDocSet().end()) {
-                            continue;
-                        }
-                        doc = lds->second.find(a.first);
-                        if (doc == lds->second.end()) {
-                            continue;
-                        }
+                    for (auto id:sc.first) {
+                        const auto &name = docTable.documents[id].name;
                         rapidjson::Value jsonArticle;
-                        jsonArticle.SetString(doc->second.name.c_str(), doc->second.name.length(),
-                                              json.GetAllocator());
+                        jsonArticle.SetString(name.c_str(), name.length(), json.GetAllocator());
                         jsonArticleArray.PushBack(jsonArticle, json.GetAllocator());
                     }
                     jsonGroupObject.AddMember("articles", jsonArticleArray, json.GetAllocator());
@@ -195,6 +235,28 @@ void cli_t::operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path) {
     json.Accept(writer);
     std::cout << jsonStr.GetString() << std::endl;
 
+    const auto &loadStat = pipeline?pipeline->loadStat():dataLoader->loadStat();
+    std::cerr << "Loaded " << loadStat.files << " files, "
+              << loadStat.bytes << " bytes (" << loadStat.mapped << " mapped, " << loadStat.uring << " io_uring), "
+              << loadStat.syscalls << " syscalls, " << loadStat.syscallsSaved << " saved" << std::endl;
+    if (pipeline) {
+        std::cerr << "Pipeline in flight high-water mark: " << pipeline->peakInFlight() << " bytes (budget "
+                  << m_pipelineSettings.memoryBudget << ")" << std::endl;
+    }
+    std::cerr << "HTML parser arena high-water mark: " << gumboArena_t::peakHighWaterMark() << " bytes, trees over "
+              << gumboArena_t::maxTreeSize << " bytes: " << gumboArena_t::overflows() << std::endl;
+    if (docCache) {
+        auto cacheStat = docCache->stat();
+        std::cerr << "Document cache: " << cacheStat.hits << " hits, " << cacheStat.misses << " misses, vectors: "
+                  << cacheStat.vectorHits << " hits, " << cacheStat.vectorMisses << " misses" << std::endl;
+        // results are already printed, the run is not failed if the cache is not saved
+        try {
+            docCache->save();
+        } catch (const std::exception &_e) {
+            std::cerr << _e.what() << std::endl;
+        }
+    }
+
 /*
         char wb[65536];
         rapidjson::FileWriteStream os(stdout, wb, sizeof(wb));
@@ -12,10 +12,15 @@ class cli_t {
 public:
     cli_t(const std::vector<std::string> &_langCodes,
           const std::unordered_map<std::string, std::string> &_w2vModels,
+          const embedderSettings_t &_embedderSettings,
           const std::unordered_map<std::string, std::string> &_newsDetectionModels,
           const std::unordered_map<std::string, std::string> &_categoryDetectionModels,
           const std::unordered_map<categories_t, std::string> &_categoryNames,
-          const std::unordered_map<std::string, float> &_similarityThreshold);
+          const std::unordered_map<std::string, float> &_similarityThreshold,
+          const pipelineSettings_t &_pipelineSettings,
+          htmlParser_t _htmlParser,
+          bool _ioUring,
+          const char *_docCacheFile);
     ~cli_t() = default;
 
     void operator()(uint8_t _threads, cmd_t _cmd, char  *const *_path);
@@ -23,10 +28,16 @@ public:
 private:
     const std::vector<std::string> &m_langCodes;
     const std::unordered_map<std::string, std::string> &m_w2vModels;
+    const embedderSettings_t m_embedderSettings;
     const std::unordered_map<std::string, std::string> &m_newsDetectionModels;
     const std::unordered_map<std::string, std::string> &m_categoryDetectionModels;
     const std::unordered_map<categories_t, std::string> &m_categoryNames;
     const std::unordered_map<std::string, float> &m_similarityThreshold;
+    const pipelineSettings_t &m_pipelineSettings;
+    const htmlParser_t m_htmlParser;
+    const bool m_ioUring;
+    // empty - the cache is disabled
+    const std::string m_docCacheFile;
 };
 
 #endif //TGNEWS_CLI_H
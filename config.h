@@ -9,9 +9,41 @@
 #define TGNEWS_CONFIG_H
 
 #include <cstdint>
+#include <cstddef>
+
+#include "types.h"
 
 static const uint8_t g_threads = 8;
 
+// HTML text extraction: full Gumbo tree or streaming scanner with Gumbo fallback
+static const htmlParser_t g_htmlParser = htmlParser_t::GUMBO;
+
+// batched asynchronous file reading for a cold page cache or slow storage, falls back to blocking reads if io_uring
+// is not available; files are copied, so cached input is faster with the default mmap path
+static const bool g_ioUring = false;
+
+// parsed documents and their vectors are cached between CLI runs (phased mode only), nullptr - disabled
+static const char *g_docCacheFile = nullptr;
+
+// CLI streaming pipeline mode: files are loaded, parsed, embedded and classified concurrently
+static const bool g_pipelineMode = false;
+static const std::size_t g_pipelineQueueSize = 64;
+static const std::size_t g_pipelineBatchSize = 64;
+// workers per pipeline stage, 0 - all available threads
+static const uint8_t g_pipelineParsers = 0;
+static const uint8_t g_pipelineLangDetectors = 2;
+static const uint8_t g_pipelineEmbedders = 0;
+static const uint8_t g_pipelineNewsDetectors = 2;
+static const uint8_t g_pipelineCategorizers = 2;
+// input contents and document texts held in flight by the pipeline, in bytes, 0 - unlimited
+static const std::size_t g_pipelineMemoryBudget = 512 * 1024 * 1024;
+
+// FAISS index vectors decoded at load (the most frequent words), the rest are decoded per token; 0 - all words.
+// A decoded vector takes vectorSize * 4 bytes (2KB for 512-dim) as fp32 per language, the index keeps the PQ codes
+static const std::size_t g_faissDecodedWords = 100000;
+// decoded FAISS vectors are stored as half precision floats
+static const bool g_faissDecodedFp16 = false;
+
 static const char *g_sqliteFile = "../db/tgnews.sqlite";
 
 static const char *g_langCodes[] = {
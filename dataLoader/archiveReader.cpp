@@ -0,0 +1,289 @@
+/**
+ * @file dataLoader/archiveReader.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <zlib.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <iostream>
+
+#include "archiveReader.h"
+
+static const std::size_t tarBlockSize = 512;
+
+static inline bool endsWith(const std::string &_str, const char *_suffix) noexcept {
+    auto len = std::strlen(_suffix);
+    return (_str.length() > len) && (_str.compare(_str.length() - len, len, _suffix) == 0);
+}
+
+// reads exactly _size bytes, false on EOF or error
+static inline bool readFull(gzFile _file, void *_buf, std::size_t _size) noexcept {
+    auto buf = static_cast<char *>(_buf);
+    while (_size > 0) {
+        auto r = gzread(_file, buf, static_cast<unsigned>((_size > archiveReader_t::bufferSize)?
+                                                           archiveReader_t::bufferSize:_size));
+        if (r <= 0) {
+            return false;
+        }
+        buf += r;
+        _size -= static_cast<std::size_t>(r);
+    }
+
+    return true;
+}
+
+static inline bool skip(gzFile _file, std::size_t _size) noexcept {
+    char buf[tarBlockSize * 8];
+    while (_size > 0) {
+        auto len = (_size > sizeof(buf))?sizeof(buf):_size;
+        if (!readFull(_file, buf, len)) {
+            return false;
+        }
+        _size -= len;
+    }
+
+    return true;
+}
+
+// octal or GNU base-256 encoded tar header number
+static inline bool tarNumber(const char *_field, std::size_t _size, uint64_t &_value) noexcept {
+    _value = 0;
+    auto p = reinterpret_cast<const uint8_t *>(_field);
+    if ((p[0] & 0x80) != 0) {
+        _value = p[0] & 0x7f;
+        for (std::size_t i = 1; i < _size; ++i) {
+            if (_value > (UINT64_MAX >> 8)) {
+                return false;
+            }
+            _value = (_value << 8) | p[i];
+        }
+        return true;
+    }
+
+    std::size_t i = 0;
+    while ((i < _size) && (p[i] == ' ')) {
+        ++i;
+    }
+    for (; (i < _size) && (p[i] >= '0') && (p[i] <= '7'); ++i) {
+        _value = (_value << 3) | (p[i] - '0');
+    }
+    // the field is terminated by NUL or space
+    return (i == _size) || (p[i] == '\0') || (p[i] == ' ');
+}
+
+static inline bool tarChecksum(const char *_header) noexcept {
+    uint64_t expected = 0;
+    if (!tarNumber(_header + 148, 8, expected)) {
+        return false;
+    }
+    uint64_t sum = 0;
+    for (std::size_t i = 0; i < tarBlockSize; ++i) {
+        // checksum field is counted as spaces
+        sum += ((i >= 148) && (i < 156))?' ':static_cast<uint8_t>(_header[i]);
+    }
+
+    return sum == expected;
+}
+
+// value of the "path" record of a pax extended header, empty if there is no such record
+static inline std::string paxPath(const std::string &_data) {
+    std::string ret;
+    std::size_t pos = 0;
+    while (pos < _data.length()) {
+        // "<length> <key>=<value>\n", length includes itself
+        std::size_t len = 0;
+        auto i = pos;
+        for (; (i < _data.length()) && (_data[i] >= '0') && (_data[i] <= '9'); ++i) {
+            len = len * 10 + (_data[i] - '0');
+        }
+        if ((len == 0) || (pos + len > _data.length()) || (i == _data.length()) || (_data[i] != ' ')) {
+            break;
+        }
+        auto record = std::string_view(_data).substr(i + 1, pos + len - i - 2);
+        if (record.compare(0, 5, "path=") == 0) {
+            ret = record.substr(5);
+        }
+        pos += len;
+    }
+
+    return ret;
+}
+
+archiveReader_t::archiveReader_t(std::size_t _batchSize) noexcept: m_batchSize((_batchSize == 0)?1:_batchSize) {
+}
+
+bool archiveReader_t::accepts(const std::string &_path) noexcept {
+    return endsWith(_path, ".tar") || endsWith(_path, ".tar.gz") || endsWith(_path, ".tgz")
+           || endsWith(_path, ".bundle") || endsWith(_path, ".bundle.gz");
+}
+
+void archiveReader_t::operator()(const std::string &_path, const consumer_t &_consumer) {
+    // compression is detected by gzip magic, not compressed files are read as is
+    auto file = gzopen(_path.c_str(), "rb");
+    if (file == nullptr) {
+        std::cerr << _path << ": " << std::strerror(errno) << std::endl;
+        return;
+    }
+    gzbuffer(file, bufferSize);
+
+    auto prefix = _path + '/';
+    const char *error = nullptr;
+    try {
+        if (endsWith(_path, ".bundle") || endsWith(_path, ".bundle.gz")) {
+            while (true) {
+                uint8_t len[4];
+                auto r = gzread(file, len, 1);
+                if (r == 0) { // end of bundle
+                    break;
+                }
+                if ((r < 0) || !readFull(file, len + 1, sizeof(len) - 1)) {
+                    error = "unexpected end of bundle";
+                    break;
+                }
+                std::size_t nameLen = len[0] | (len[1] << 8) | (len[2] << 16) | (static_cast<uint32_t>(len[3]) << 24);
+                if (nameLen > 4096) {
+                    error = "corrupted bundle";
+                    break;
+                }
+                std::string name(nameLen, '\0');
+                if (!readFull(file, name.data(), nameLen) || !readFull(file, len, sizeof(len))) {
+                    error = "unexpected end of bundle";
+                    break;
+                }
+                std::size_t size = len[0] | (len[1] << 8) | (len[2] << 16) | (static_cast<uint32_t>(len[3]) << 24);
+                if (size > maxMemberSize) {
+                    std::cerr << prefix << name << ": file is too large, skipped" << std::endl;
+                    if (!skip(file, size)) {
+                        error = "unexpected end of bundle";
+                        break;
+                    }
+                    continue;
+                }
+                std::string content(size, '\0');
+                if (!readFull(file, content.data(), size)) {
+                    error = "unexpected end of bundle";
+                    break;
+                }
+                add(prefix, name, std::move(content), _consumer);
+            }
+        } else {
+            char header[tarBlockSize];
+            // GNU or pax long name of the next member
+            std::string longName;
+            while (true) {
+                auto r = gzread(file, header, sizeof(header));
+                if (r == 0) { // some writers omit the end of archive blocks
+                    break;
+                }
+                if ((r < 0) || !readFull(file, header + r, sizeof(header) - static_cast<std::size_t>(r))) {
+                    error = "unexpected end of archive";
+                    break;
+                }
+                // archive ends with zero blocks
+                if ((header[0] == '\0') && (std::memcmp(header, header + 1, sizeof(header) - 1) == 0)) {
+                    break;
+                }
+                uint64_t size = 0;
+                if (!tarChecksum(header) || !tarNumber(header + 124, 12, size)) {
+                    error = "corrupted archive";
+                    break;
+                }
+                auto padded = (size + tarBlockSize - 1) / tarBlockSize * tarBlockSize;
+
+                std::string name;
+                if (!longName.empty()) {
+                    name.swap(longName);
+                } else {
+                    name.assign(header, strnlen(header, 100));
+                    // ustar splits long names to prefix and name
+                    if ((std::memcmp(header + 257, "ustar", 5) == 0) && (header[345] != '\0')) {
+                        name = std::string(header + 345, strnlen(header + 345, 155)) + '/' + name;
+                    }
+                }
+
+                auto type = header[156];
+                bool regular = (type == '0') || (type == '\0') || (type == '7');
+                if (((type == 'L') || (type == 'x') || regular) && (size <= maxMemberSize)) {
+                    std::string content(size, '\0');
+                    if (!readFull(file, content.data(), size) || !skip(file, padded - size)) {
+                        error = "unexpected end of archive";
+                        break;
+                    }
+                    if (type == 'L') {
+                        longName.assign(content.c_str());
+                    } else if (type == 'x') {
+                        longName = paxPath(content);
+                    } else {
+                        add(prefix, name, std::move(content), _consumer);
+                    }
+                    continue;
+                }
+
+                if (regular) {
+                    std::cerr << prefix << name << ": file is too large, skipped" << std::endl;
+                }
+                // directories, links, devices and global headers
+                if (!skip(file, padded)) {
+                    error = "unexpected end of archive";
+                    break;
+                }
+            }
+        }
+
+        if (error != nullptr) {
+            int errnum = Z_OK;
+            auto zError = gzerror(file, &errnum);
+            if (errnum != Z_OK) { // zlib message contains the file name
+                std::cerr << zError << std::endl;
+            } else {
+                std::cerr << _path << ": " << error << std::endl;
+            }
+        }
+        flush(_consumer);
+    } catch (...) {
+        gzclose(file);
+        m_files.clear();
+        m_contents.clear();
+        m_bytes = 0;
+        throw;
+    }
+    gzclose(file);
+}
+
+void archiveReader_t::add(const std::string &_path,
+                          const std::string &_name,
+                          std::string &&_content,
+                          const consumer_t &_consumer) {
+    auto pos = _name.rfind('/');
+    if (_name.empty()) {
+        return;
+    }
+    if (pos == std::string::npos) {
+        m_files.emplace_back(_path, _name);
+    } else if (pos + 1 < _name.length()) {
+        m_files.emplace_back(_path + _name.substr(0, pos + 1), _name.substr(pos + 1));
+    } else { // directory
+        return;
+    }
+    m_bytes += _content.size();
+    m_contents.emplace_back(std::move(_content));
+
+    if ((m_files.size() >= m_batchSize) || (m_bytes >= maxBatchBytes)) {
+        flush(_consumer);
+    }
+}
+
+void archiveReader_t::flush(const consumer_t &_consumer) {
+    if (m_files.empty()) {
+        return;
+    }
+    _consumer(std::move(m_files), std::move(m_contents));
+    m_files = fileEnumerator_t::fileBatch_t();
+    m_contents = std::vector<std::string>();
+    m_bytes = 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file dataLoader/archiveReader.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_ARCHIVEREADER_H
+#define TGNEWS_ARCHIVEREADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "fileEnumerator.h"
+
+// Sequential reader of input dumps: tar archives (ustar, GNU and pax long names) and length-prefixed bundles, both
+// optionally gzip compressed. Regular members are passed to the consumer in batches together with their contents,
+// nothing is extracted to disk.
+// Bundle is a sequence of records: uint32_t name length, name, uint32_t content length, content (little endian).
+class archiveReader_t final {
+public:
+    // a batch is passed to the consumer when it has _batchSize members or this amount of content
+    static const std::size_t maxBatchBytes = 4 * 1024 * 1024;
+    // larger members are skipped
+    static const std::size_t maxMemberSize = 64 * 1024 * 1024;
+    // decompression buffer size
+    static const unsigned bufferSize = 256 * 1024;
+
+    // member paths (with trailing '/') and names, and their contents
+    using consumer_t = std::function<void(fileEnumerator_t::fileBatch_t &&_files,
+                                          std::vector<std::string> &&_contents)>;
+
+    explicit archiveReader_t(std::size_t _batchSize) noexcept;
+
+    // true for .tar, .tar.gz, .tgz, .bundle and .bundle.gz files
+    static bool accepts(const std::string &_path) noexcept;
+
+    // member paths are prefixed with the archive path, so names from different archives do not collide;
+    // read errors are reported, members read so far are passed to the consumer
+    void operator()(const std::string &_path, const consumer_t &_consumer);
+
+private:
+    const std::size_t m_batchSize;
+
+    fileEnumerator_t::fileBatch_t m_files;
+    std::vector<std::string> m_contents;
+    std::size_t m_bytes = 0;
+
+    void add(const std::string &_path, const std::string &_name, std::string &&_content, const consumer_t &_consumer);
+    void flush(const consumer_t &_consumer);
+};
+
+#endif //TGNEWS_ARCHIVEREADER_H
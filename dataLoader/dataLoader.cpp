@@ -5,8 +5,8 @@
  * @date 02.12.2019
 */
 
+#include <cstdio>
 #include <thread>
-#include <fstream>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -26,103 +26,241 @@
 #pragma GCC diagnostic pop
 #endif
 
-#include "fileEnumerator.h"
+#include "mappedFile.h"
 #include "dataLoader.h"
 
 dataLoader_t::dataLoader_t(uint8_t _threads,
                            const std::vector<std::string> &_langs,
                            char  *const *_path,
-                           bool _allLangs): m_allLangs(_allLangs) {
+                           bool _allLangs,
+                           htmlParser_t _htmlParser,
+                           bool _ioUring,
+                           docCache_t *_docCache):
+        m_allLangs(_allLangs), m_htmlParser(_htmlParser), m_ioUring(_ioUring), m_docCache(_docCache) {
     if (!m_allLangs) {
         for (const auto &s:_langs) {
-            m_langDocSet.emplace(s, docSet_t());
+            m_langDocSet.emplace(s, docIds_t());
         }
     }
 
-    fileEnumerator_t fe;
+    // loading starts as soon as the first files are found. The queue balances the load between workers, as the chunk
+    // scheduler did: a free worker pops the next batch, so a slow batch delays only its own worker
+    boundedQueue_t<inputBatch_t> fileQueue(fileQueueSize);
     std::vector<std::thread> thrPool;
-    const auto &fileNames = fe(_path);
-    uint8_t workers = fileNames.empty()?0:((fileNames.size() < _threads)?fileNames.size():_threads);
+    auto workers = (_threads == 0)?1:_threads;
     for (int i = 0; i < workers; ++i) {
-        thrPool.emplace_back(std::thread(&dataLoader_t::worker, this, i, workers, std::cref(fileNames)));
+        thrPool.emplace_back(std::thread(&dataLoader_t::worker, this, std::ref(fileQueue)));
     }
+    try {
+        enumerate(_threads, fileBatchSize, _path, [&fileQueue](inputBatch_t &&_batch) {
+            fileQueue.push(std::move(_batch));
+        });
+    } catch (...) {
+        fileQueue.close();
+        for (auto &i:thrPool) {
+            i.join();
+        }
+        throw;
+    }
+    fileQueue.close();
     for (auto &i:thrPool) {
         i.join();
     }
+
+    std::size_t documents = 0;
+    for (const auto &wd:m_workerDocs) {
+        for (const auto &t:wd.second) {
+            documents += t.size();
+        }
+    }
+    m_docTable.fileNames.reserve(documents);
+    m_docTable.documents.reserve(documents);
+    m_docTable.vectorRows.reserve(documents);
+    for (auto &wd:m_workerDocs) {
+        auto &ids = m_langDocSet[wd.first];
+        for (auto &t:wd.second) {
+            for (std::size_t i = 0; i < t.size(); ++i) {
+                ids.emplace_back(m_docTable.add(std::move(t.fileNames[i]), std::move(t.documents[i])));
+            }
+            t = docTable_t();
+        }
+    }
+    m_workerDocs.clear();
 }
 
-bool dataLoader_t::loadFile(const std::string &_fileName, std::vector<uint8_t> &_data) noexcept {
-    try {
-        std::ifstream ifs;
-        ifs.exceptions(std::ifstream::failbit);
-        ifs.open(_fileName, std::ifstream::in | std::ifstream::binary);
-        auto startPos = ifs.tellg();
-        ifs.ignore(std::numeric_limits<std::streamsize>::max());
-        auto size = static_cast<std::size_t>(ifs.gcount());
-        ifs.seekg(startPos);
-        _data.resize(size);
-        ifs.read(reinterpret_cast<char *>(_data.data()), size);
-        ifs.close();
-
-        return true;
-    } catch (const std::exception &_e) {
-        std::cerr << _e.what() << std::endl;
-    } catch (...) {
-        std::cerr << "unknown error" << std::endl;
+dataLoader_t::loadStat_t &dataLoader_t::loadStat_t::operator+=(const loadStat_t &_r) noexcept {
+    files += _r.files;
+    mapped += _r.mapped;
+    uring += _r.uring;
+    bytes += _r.bytes;
+    syscalls += _r.syscalls;
+    syscallsSaved += _r.syscallsSaved;
+
+    return *this;
+}
+
+void dataLoader_t::enumerate(uint8_t _threads,
+                             std::size_t _batchSize,
+                             char *const *_path,
+                             const inputConsumer_t &_consumer) {
+    std::vector<char *> paths;
+    for (auto path = _path; *path != nullptr; ++path) {
+        if (archiveReader_t::accepts(*path)) {
+            // decompression is sequential, members are parsed by the workers concurrently
+            archiveReader_t ar(_batchSize);
+            ar(*path, [&_consumer](fileEnumerator_t::fileBatch_t &&_files, std::vector<std::string> &&_contents) {
+                _consumer(inputBatch_t{std::move(_files), std::move(_contents)});
+            });
+        } else {
+            paths.emplace_back(*path);
+        }
+    }
+    if (paths.empty()) {
+        return;
     }
+    paths.emplace_back(nullptr);
 
-    return false;
+    fileEnumerator_t fe(_threads, _batchSize);
+    fe(paths.data(), [&_consumer](fileEnumerator_t::fileBatch_t &&_files) {
+        _consumer(inputBatch_t{std::move(_files), std::vector<std::string>()});
+    });
 }
 
-void dataLoader_t::worker(uint8_t _thrID, uint8_t _threads,
-                          const std::vector<std::pair<std::string, std::string>> &_fileNames) noexcept {
-    std::size_t filesPerThread = _fileNames.size() / _threads;
-    std::size_t startFrom = _thrID * filesPerThread;
-    std::size_t stopAt = ((_thrID == _threads - 1)?_fileNames.size():startFrom + filesPerThread);
+bool dataLoader_t::loadFile(const std::string &_fileName, mappedFile_t &_file, loadStat_t &_loadStat) noexcept {
+    std::size_t syscalls = 0;
+    auto ret = _file.open(_fileName, syscalls);
+    _loadStat.syscalls += syscalls;
+    if (!ret) {
+        return false;
+    }
 
+    // open, lseek (tellg), read per BUFSIZ block + EOF read (ignore), lseek (seekg), read, close
+    std::size_t streamSyscalls = 6 + (_file.size() + BUFSIZ - 1) / BUFSIZ;
+    if (streamSyscalls > syscalls) {
+        _loadStat.syscallsSaved += streamSyscalls - syscalls;
+    }
+    _loadStat.files++;
+    _loadStat.bytes += _file.size();
+    if (_file.mapped()) {
+        _loadStat.mapped++;
+    }
+
+    return true;
+}
+
+void dataLoader_t::loadFiles(const inputBatch_t &_batch,
+                             uringReader_t *_reader,
+                             mappedFile_t &_file,
+                             loadStat_t &_loadStat,
+                             const uringReader_t::consumer_t &_consumer) {
+    const auto &files = _batch.files;
+    if (!_batch.contents.empty()) {
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            const auto &content = _batch.contents[i];
+            _loadStat.files++;
+            _loadStat.bytes += content.size();
+            _consumer(i, reinterpret_cast<const uint8_t *>(content.data()), content.size());
+        }
+        return;
+    }
+
+    if ((_reader == nullptr) || !_reader->available()) {
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            if (loadFile(files[i].first + files[i].second, _file, _loadStat)) {
+                _consumer(i, _file.data(), _file.size());
+            }
+        }
+        _file.close();
+        return;
+    }
+
+    std::size_t syscalls = 0;
+    std::size_t streamSyscalls = 0;
+    (*_reader)(files, [&_loadStat, &streamSyscalls, &_consumer](std::size_t _idx,
+                                                                 const uint8_t *_data,
+                                                                 std::size_t _size) {
+        _loadStat.files++;
+        _loadStat.uring++;
+        _loadStat.bytes += _size;
+        streamSyscalls += 6 + (_size + BUFSIZ - 1) / BUFSIZ;
+        _consumer(_idx, _data, _size);
+    }, syscalls);
+    _loadStat.syscalls += syscalls;
+    if (streamSyscalls > syscalls) {
+        _loadStat.syscallsSaved += streamSyscalls - syscalls;
+    }
+}
+
+void dataLoader_t::worker(boundedQueue_t<inputBatch_t> &_fileQueue) noexcept {
     try {
         thread_local std::unique_ptr<chrome_lang_id::NNetLanguageIdentifier> lang_id;
         {
             std::unique_lock<std::mutex> lck(m_mtx);
             lang_id = std::make_unique<chrome_lang_id::NNetLanguageIdentifier>(0, 1024);
         }
-        textExtractor_t te;
-
-        for (auto i = startFrom; i < stopAt; ++i) {
-            document_t data;
-            data.name = _fileNames[i].second;
-            std::vector<uint8_t> body;
-            std::string absFileName = _fileNames[i].first + _fileNames[i].second;
-            if (loadFile(absFileName, body) && te(body, data)) {
-                std::string doc(data.title);
-                if (!data.text.empty()) {
-                    if (doc.empty()) {
-                        doc = data.text;
-                    } else {
-                        doc += ". " + data.text;
+        textExtractor_t te(m_htmlParser);
+        mappedFile_t body;
+        std::unique_ptr<uringReader_t> reader;
+        if (m_ioUring) {
+            reader = std::make_unique<uringReader_t>();
+        }
+        loadStat_t loadStat;
+        // documents are collected by every worker independently and passed to m_workerDocs at once
+        std::unordered_map<std::string, docTable_t> langDocs;
+
+        inputBatch_t fileBatch;
+        while (_fileQueue.pop(fileBatch)) {
+            loadFiles(fileBatch, reader.get(), body, loadStat,
+                      [&](std::size_t _idx, const uint8_t *_data, std::size_t _size) {
+                const auto &f = fileBatch.files[_idx];
+                std::string absFileName = f.first + f.second;
+                document_t data;
+                data.name = f.second;
+                // empty if the document is skipped
+                std::string langCode;
+                docCache_t::contentKey_t key;
+                if (m_docCache != nullptr) {
+                    key = docCache_t::key(_data, _size);
+                }
+                if ((m_docCache == nullptr) || !m_docCache->lookup(absFileName, key, data, langCode)) {
+                    if (te(_data, _size, data)) {
+                        std::string doc(data.title);
+                        if (!data.text.empty()) {
+                            if (doc.empty()) {
+                                doc = data.text;
+                            } else {
+                                doc += ". " + data.text;
+                            }
+                        }
+                        if (!doc.empty()) {
+                            langCode = lang_id->FindLanguage(doc).language;
+                        }
+                    }
+                    if (m_docCache != nullptr) {
+                        if (langCode.empty()) {
+                            m_docCache->insert(absFileName, key, document_t(), langCode);
+                        } else {
+                            m_docCache->insert(absFileName, key, data, langCode);
+                        }
                     }
                 }
-                if (doc.empty()) {
-                    continue;
+                if (langCode.empty()) {
+                    return;
                 }
 
-                const chrome_lang_id::NNetLanguageIdentifier::Result r = lang_id->FindLanguage(doc);
-                std::unique_lock<std::mutex> lck(m_mtx);
-                auto l = m_langDocSet.find(r.language);
-                if (m_allLangs) {
-                    if (l == m_langDocSet.end()) {
-                        auto l1 = m_langDocSet.emplace(r.language, docSet_t());
-                        l1.first->second.emplace(absFileName, data);
-                    } else {
-                        l->second.emplace(absFileName, data);
-                    }
-                } else {
-                    if (l != m_langDocSet.end()) {
-                        l->second.emplace(absFileName, data);
-                    }
+                // m_langDocSet keys are not changed while workers are running, if languages are filtered
+                if (!m_allLangs && (m_langDocSet.find(langCode) == m_langDocSet.end())) {
+                    return;
                 }
-            }
+                langDocs[langCode].add(std::move(absFileName), std::move(data));
+            });
+        }
+
+        std::unique_lock<std::mutex> lck(m_mtx);
+        for (auto &l:langDocs) {
+            m_workerDocs[l.first].emplace_back(std::move(l.second));
         }
+        m_loadStat += loadStat;
     } catch (const std::exception &_e) {
         std::cerr << _e.what() << std::endl;
     } catch (...) {
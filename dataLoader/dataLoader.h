@@ -12,26 +12,86 @@
 #include <unordered_set>
 
 #include "types.h"
+#include "scheduler/boundedQueue.h"
+#include "fileEnumerator.h"
+#include "archiveReader.h"
+#include "uringReader.h"
+#include "docCache.h"
 #include "textExtractor.h"
 
+class mappedFile_t;
+
 class dataLoader_t final {
+public:
+    // files are passed from the enumerator to the loading workers in batches
+    static const std::size_t fileBatchSize = 256;
+    // max batches in flight
+    static const std::size_t fileQueueSize = 64;
+
+    // files to read from disk or archive members with their contents
+    struct inputBatch_t {
+        fileEnumerator_t::fileBatch_t files;
+        // empty for files on disk
+        std::vector<std::string> contents;
+    };
+    using inputConsumer_t = std::function<void(inputBatch_t &&_batch)>;
+
+    // file loading statistics
+    struct loadStat_t {
+        uint64_t files = 0;
+        uint64_t mapped = 0;
+        // read via io_uring
+        uint64_t uring = 0;
+        uint64_t bytes = 0;
+        uint64_t syscalls = 0;
+        // estimated difference to the std::ifstream based reading (open, tellg, ignore, seekg, read, close)
+        uint64_t syscallsSaved = 0;
+
+        loadStat_t &operator+=(const loadStat_t &_r) noexcept;
+    };
+
 private:
+    docTable_t m_docTable;
     langDocSet_t m_langDocSet;
+    // documents collected by workers, by language; moved to m_docTable when all workers are done
+    std::unordered_map<std::string, std::vector<docTable_t>> m_workerDocs;
+    loadStat_t m_loadStat;
     std::mutex m_mtx;
     bool m_allLangs = false;
+    htmlParser_t m_htmlParser = htmlParser_t::GUMBO;
+    bool m_ioUring = false;
+    docCache_t *m_docCache = nullptr;
 
 public:
     dataLoader_t(uint8_t _threads,
                  const std::vector<std::string> &_langs,
                  char  *const *_path,
-                 bool _allLangs = false);
+                 bool _allLangs = false,
+                 htmlParser_t _htmlParser = htmlParser_t::GUMBO,
+                 bool _ioUring = false,
+                 docCache_t *_docCache = nullptr);
 
-    static bool loadFile(const std::string &_fileName, std::vector<uint8_t> &_data) noexcept;
+    // archives and bundles are read member by member, directories are walked by _threads threads;
+    // batches are passed to the consumer as soon as they are ready
+    static void enumerate(uint8_t _threads,
+                          std::size_t _batchSize,
+                          char *const *_path,
+                          const inputConsumer_t &_consumer);
+    static bool loadFile(const std::string &_fileName, mappedFile_t &_file, loadStat_t &_loadStat) noexcept;
+    // archive members are passed as is, files are read via io_uring if the reader is available, one by one otherwise;
+    // files are passed to the consumer in completion order
+    static void loadFiles(const inputBatch_t &_batch,
+                          uringReader_t *_reader,
+                          mappedFile_t &_file,
+                          loadStat_t &_loadStat,
+                          const uringReader_t::consumer_t &_consumer);
+    // documents of the same language have consecutive ids
+    docTable_t &docTable() noexcept {return m_docTable;}
     const langDocSet_t &langDocSet() noexcept {return m_langDocSet;}
+    [[nodiscard]] const loadStat_t &loadStat() const noexcept {return m_loadStat;}
 
 private:
-    void worker(uint8_t _thrID, uint8_t _threads,
-                const std::vector<std::pair<std::string, std::string>> &_fileNames) noexcept;
+    void worker(boundedQueue_t<inputBatch_t> &_fileQueue) noexcept;
 };
 
 #endif //TGNEWS_DATALOADER_H
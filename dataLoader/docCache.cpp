@@ -0,0 +1,530 @@
+/**
+ * @file dataLoader/docCache.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "docCache.h"
+
+// file layout: header, fingerprint, index sorted by key, records; index and records are 8 bytes aligned
+static const char cacheMagic[8] = {'T', 'G', 'N', 'C', 'A', 'C', 'H', 'E'};
+static const uint32_t cacheVersion = 1;
+
+struct cacheHeader_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t fingerprintSize;
+    uint64_t entries;
+};
+
+struct docCache_t::index_t {
+    uint64_t hash;
+    uint64_t size;
+    uint64_t offset;
+    uint64_t length;
+};
+
+// followed by the vector, the language code, site, title and text
+struct cacheRecord_t {
+    uint64_t time;
+    uint32_t siteSize;
+    uint32_t titleSize;
+    uint32_t textSize;
+    uint16_t vectorSize;
+    uint8_t langCodeSize;
+    uint8_t reserved;
+};
+
+static inline std::size_t align8(std::size_t _value) noexcept {
+    return (_value + 7) & ~static_cast<std::size_t>(7);
+}
+
+// the record header of _length bytes at _offset, false if it is out of _size or its sizes do not sum up to _length
+static bool readRecord(const uint8_t *_data, std::size_t _size, uint64_t _offset, uint64_t _length,
+                       cacheRecord_t &_record) noexcept {
+    if ((_offset > _size) || (_length > _size - _offset) || (_length < sizeof(cacheRecord_t))) {
+        return false;
+    }
+    std::memcpy(&_record, _data + _offset, sizeof(_record));
+
+    return sizeof(_record) + _record.vectorSize * sizeof(float) + _record.langCodeSize + _record.siteSize
+           + _record.titleSize + _record.textSize == _length;
+}
+
+static bool writeAll(int _fd, const char *_data, std::size_t _size, uint64_t _offset) noexcept {
+    while (_size > 0) {
+        auto ret = ::pwrite(_fd, _data, _size, static_cast<off_t>(_offset));
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        _data += ret;
+        _size -= static_cast<std::size_t>(ret);
+        _offset += static_cast<uint64_t>(ret);
+    }
+
+    return true;
+}
+
+static bool readAll(int _fd, uint8_t *_data, std::size_t _size, uint64_t _offset) noexcept {
+    while (_size > 0) {
+        auto ret = ::pread(_fd, _data, _size, static_cast<off_t>(_offset));
+        if (ret <= 0) {
+            if ((ret < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return false;
+        }
+        _data += ret;
+        _size -= static_cast<std::size_t>(ret);
+        _offset += static_cast<uint64_t>(ret);
+    }
+
+    return true;
+}
+
+docCache_t::docCache_t(std::string _fileName, std::string _fingerprint):
+        m_fileName(std::move(_fileName)), m_fingerprint(std::move(_fingerprint)) {
+    load();
+
+    // the journal is removed by the system when the cache is destroyed or the process exits
+    auto journalName = m_fileName + ".XXXXXX";
+    m_journal = mkostemp(journalName.data(), O_CLOEXEC);
+    if (m_journal < 0) {
+        std::cerr << journalName << ": " << std::strerror(errno) << ", new documents are not cached" << std::endl;
+    } else {
+        ::unlink(journalName.c_str());
+    }
+}
+
+docCache_t::~docCache_t() {
+    if (m_data != nullptr) {
+        munmap(const_cast<uint8_t *>(m_data), m_size);
+    }
+    if (m_journal >= 0) {
+        ::close(m_journal);
+    }
+}
+
+std::string docCache_t::fingerprint(const std::vector<std::string> &_files, const std::string &_settings) {
+    auto files = _files;
+    std::sort(files.begin(), files.end());
+    std::string ret = _settings;
+    for (const auto &f:files) {
+        ret += '|' + f;
+        struct stat st {};
+        if (::stat(f.c_str(), &st) == 0) {
+            ret += ':' + std::to_string(st.st_size) + ':' + std::to_string(st.st_mtime);
+        }
+    }
+
+    return ret;
+}
+
+// MurmurHash64A
+docCache_t::contentKey_t docCache_t::key(const uint8_t *_data, std::size_t _size) noexcept {
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+
+    uint64_t h = 0x9747b28cULL ^ (_size * m);
+    auto end = _data + (_size & ~static_cast<std::size_t>(7));
+    for (auto p = _data; p != end; p += 8) {
+        uint64_t k;
+        std::memcpy(&k, p, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    switch (_size & 7) {
+        case 7: h ^= static_cast<uint64_t>(end[6]) << 48; [[fallthrough]];
+        case 6: h ^= static_cast<uint64_t>(end[5]) << 40; [[fallthrough]];
+        case 5: h ^= static_cast<uint64_t>(end[4]) << 32; [[fallthrough]];
+        case 4: h ^= static_cast<uint64_t>(end[3]) << 24; [[fallthrough]];
+        case 3: h ^= static_cast<uint64_t>(end[2]) << 16; [[fallthrough]];
+        case 2: h ^= static_cast<uint64_t>(end[1]) << 8; [[fallthrough]];
+        case 1: h ^= static_cast<uint64_t>(end[0]);
+            h *= m;
+            break;
+        default:
+            break;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+
+    contentKey_t ret;
+    ret.hash = h;
+    ret.size = _size;
+    return ret;
+}
+
+void docCache_t::load() {
+    auto fd = ::open(m_fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { // the first run
+        return;
+    }
+    struct stat st {};
+    if ((fstat(fd, &st) != 0) || (static_cast<std::size_t>(st.st_size) < sizeof(cacheHeader_t))) {
+        ::close(fd);
+        return;
+    }
+    auto addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << m_fileName << ": " << std::strerror(errno) << std::endl;
+        return;
+    }
+    m_data = static_cast<const uint8_t *>(addr);
+    m_size = st.st_size;
+
+    cacheHeader_t header {};
+    std::memcpy(&header, m_data, sizeof(header));
+    auto indexOffset = align8(sizeof(header) + header.fingerprintSize);
+    bool valid = (std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) == 0)
+                 && (header.version == cacheVersion)
+                 && (indexOffset <= m_size)
+                 && ((m_size - indexOffset) / sizeof(index_t) >= header.entries);
+    if (valid && (m_fingerprint.compare(0, std::string::npos,
+                                        reinterpret_cast<const char *>(m_data) + sizeof(header),
+                                        header.fingerprintSize) != 0)) {
+        std::cerr << m_fileName << ": models or settings are changed, cache is dropped" << std::endl;
+        valid = false;
+    }
+    if (!valid) {
+        munmap(addr, m_size);
+        m_data = nullptr;
+        m_size = 0;
+        return;
+    }
+
+    m_index = reinterpret_cast<const index_t *>(m_data + indexOffset);
+    m_entries = header.entries;
+    m_used = std::vector<std::atomic<bool>>(m_entries);
+}
+
+const docCache_t::index_t *docCache_t::find(const contentKey_t &_key) const noexcept {
+    auto end = m_index + m_entries;
+    auto ret = std::lower_bound(m_index, end, _key, [](const index_t &_index, const contentKey_t &_k) {
+        return (_index.hash < _k.hash) || ((_index.hash == _k.hash) && (_index.size < _k.size));
+    });
+    if ((ret == end) || (ret->hash != _key.hash) || (ret->size != _key.size)) {
+        return nullptr;
+    }
+
+    return ret;
+}
+
+bool docCache_t::decode(const uint8_t *_data, std::size_t _size, uint64_t _offset, uint64_t _length,
+                        entry_t &_entry, bool _vector) {
+    cacheRecord_t record {};
+    if (!readRecord(_data, _size, _offset, _length, record)) {
+        return false;
+    }
+    std::size_t vectorLength = record.vectorSize * sizeof(float);
+    auto p = _data + _offset + sizeof(record);
+
+    if (_vector && (vectorLength > 0)) {
+        _entry.vector.resize(record.vectorSize);
+        std::memcpy(_entry.vector.data(), p, vectorLength);
+    }
+    p += vectorLength;
+    auto str = reinterpret_cast<const char *>(p);
+    _entry.langCode.assign(str, record.langCodeSize);
+    str += record.langCodeSize;
+    _entry.document.site.assign(str, record.siteSize);
+    str += record.siteSize;
+    _entry.document.title.assign(str, record.titleSize);
+    str += record.titleSize;
+    _entry.document.text.assign(str, record.textSize);
+    _entry.document.time = record.time;
+
+    return true;
+}
+
+bool docCache_t::lookup(const std::string &_fileName,
+                        const contentKey_t &_key,
+                        document_t &_document,
+                        std::string &_langCode) {
+    bool journal = false;
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        m_files[_fileName] = _key;
+        // duplicates of documents parsed by this run are read back from the journal
+        auto n = m_new.find(_key);
+        if ((n != m_new.end()) && (n->second.index == nullptr)) {
+            journal = true;
+            offset = n->second.offset;
+            length = n->second.length;
+        }
+    }
+
+    entry_t entry;
+    if (journal) {
+        std::vector<uint8_t> record(length);
+        if (!readAll(m_journal, record.data(), record.size(), offset)
+            || !decode(record.data(), record.size(), 0, record.size(), entry, false)) {
+            ++m_misses;
+            return false;
+        }
+    } else {
+        auto index = find(_key);
+        if ((index == nullptr) || !decode(m_data, m_size, index->offset, index->length, entry, false)) {
+            ++m_misses;
+            return false;
+        }
+        m_used[index - m_index].store(true, std::memory_order_relaxed);
+    }
+    _document.site = std::move(entry.document.site);
+    _document.title = std::move(entry.document.title);
+    _document.text = std::move(entry.document.text);
+    _document.time = entry.document.time;
+    _langCode = std::move(entry.langCode);
+    ++m_hits;
+
+    return true;
+}
+
+void docCache_t::insert(const std::string &_fileName,
+                        const contentKey_t &_key,
+                        const document_t &_document,
+                        const std::string &_langCode) {
+    cacheRecord_t header {};
+    header.time = _document.time;
+    header.siteSize = static_cast<uint32_t>(_document.site.size());
+    header.titleSize = static_cast<uint32_t>(_document.title.size());
+    header.textSize = static_cast<uint32_t>(_document.text.size());
+    header.langCodeSize = static_cast<uint8_t>(_langCode.size());
+    std::string record(reinterpret_cast<const char *>(&header), sizeof(header));
+    record.reserve(sizeof(header) + _langCode.size() + _document.site.size() + _document.title.size()
+                   + _document.text.size());
+    record += _langCode;
+    record += _document.site;
+    record += _document.title;
+    record += _document.text;
+
+    uint64_t offset = 0;
+    {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        m_files[_fileName] = _key;
+        if ((m_journal < 0) || (m_new.find(_key) != m_new.end())) {
+            return;
+        }
+        offset = m_journalSize;
+        m_journalSize += record.size();
+    }
+    // the range is reserved, records are written concurrently
+    if (!writeAll(m_journal, record.data(), record.size(), offset)) {
+        std::cerr << m_fileName << ": failed to write cache journal, " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    newEntry_t entry;
+    entry.offset = offset;
+    entry.length = record.size();
+    std::unique_lock<std::mutex> lck(m_mtx);
+    m_new.emplace(_key, std::move(entry));
+}
+
+bool docCache_t::lookupVector(const std::string &_fileName, float *_vector, std::size_t _size) {
+    auto f = m_files.find(_fileName);
+    if (f != m_files.end()) {
+        auto n = m_new.find(f->second);
+        if (n != m_new.end()) {
+            if (n->second.vector.size() == _size) {
+                std::copy(n->second.vector.begin(), n->second.vector.end(), _vector);
+                ++m_vectorHits;
+                return true;
+            }
+        } else {
+            entry_t entry;
+            auto index = find(f->second);
+            if ((index != nullptr) && decode(m_data, m_size, index->offset, index->length, entry, true)
+                && (entry.vector.size() == _size)) {
+                std::copy(entry.vector.begin(), entry.vector.end(), _vector);
+                ++m_vectorHits;
+                return true;
+            }
+        }
+    }
+    ++m_vectorMisses;
+
+    return false;
+}
+
+void docCache_t::insertVector(const std::string &_fileName, const float *_vector, std::size_t _size) {
+    std::unique_lock<std::mutex> lck(m_mtx);
+    auto f = m_files.find(_fileName);
+    if (f == m_files.end()) {
+        return;
+    }
+    auto n = m_new.find(f->second);
+    if (n == m_new.end()) {
+        // the document is cached by the previous run, the entry refers its record and replaces the vector
+        auto index = find(f->second);
+        if (index == nullptr) {
+            return;
+        }
+        newEntry_t entry;
+        entry.index = index;
+        entry.offset = index->offset;
+        entry.length = index->length;
+        n = m_new.emplace(f->second, std::move(entry)).first;
+    }
+    n->second.vector.assign(_vector, _vector + _size);
+}
+
+void docCache_t::save() {
+    std::unique_lock<std::mutex> lck(m_mtx);
+
+    // records of the new entries are copied from the mapped journal
+    struct journalMap_t {
+        const uint8_t *data = nullptr;
+        std::size_t size = 0;
+
+        ~journalMap_t() {
+            if (data != nullptr) {
+                munmap(const_cast<uint8_t *>(data), size);
+            }
+        }
+    } journal;
+    if (m_journalSize > 0) {
+        auto addr = mmap(nullptr, m_journalSize, PROT_READ, MAP_SHARED, m_journal, 0);
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error("failed to map cache journal of " + m_fileName + ", " + std::strerror(errno));
+        }
+        journal.data = static_cast<const uint8_t *>(addr);
+        journal.size = m_journalSize;
+    }
+
+    // a record, its vector is replaced if vector is set
+    struct item_t {
+        contentKey_t key;
+        const uint8_t *record;
+        uint64_t length;
+        const std::vector<float> *vector;
+    };
+    std::vector<item_t> items;
+    items.reserve(m_new.size() + m_entries);
+    for (const auto &n:m_new) {
+        auto data = (n.second.index != nullptr)?m_data:journal.data;
+        auto size = (n.second.index != nullptr)?m_size:journal.size;
+        cacheRecord_t record {};
+        if (!readRecord(data, size, n.second.offset, n.second.length, record)) {
+            continue;
+        }
+        items.push_back({n.first, data + n.second.offset, n.second.length,
+                         n.second.vector.empty()?nullptr:&n.second.vector});
+    }
+    // entries of the current run first
+    for (auto used:{true, false}) {
+        for (std::size_t i = 0; (i < m_entries) && (items.size() < maxEntries); ++i) {
+            if (m_used[i].load(std::memory_order_relaxed) != used) {
+                continue;
+            }
+            contentKey_t key;
+            key.hash = m_index[i].hash;
+            key.size = m_index[i].size;
+            if (m_new.find(key) == m_new.end()) {
+                items.push_back({key, m_data + m_index[i].offset, m_index[i].length, nullptr});
+            }
+        }
+    }
+    if (items.size() > maxEntries) {
+        items.resize(maxEntries);
+    }
+    std::sort(items.begin(), items.end(), [](const item_t &_l, const item_t &_r) {return _l.key < _r.key;});
+
+    cacheHeader_t header {};
+    std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = cacheVersion;
+    header.fingerprintSize = static_cast<uint32_t>(m_fingerprint.size());
+    header.entries = items.size();
+
+    std::vector<index_t> index(items.size());
+    auto offset = align8(align8(sizeof(header) + m_fingerprint.size()) + items.size() * sizeof(index_t));
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        index[i].hash = items[i].key.hash;
+        index[i].size = items[i].key.size;
+        index[i].offset = offset;
+        index[i].length = items[i].length;
+        if (items[i].vector != nullptr) {
+            cacheRecord_t record {};
+            std::memcpy(&record, items[i].record, sizeof(record));
+            index[i].length = index[i].length - record.vectorSize * sizeof(float)
+                              + items[i].vector->size() * sizeof(float);
+        }
+        offset = align8(offset + index[i].length);
+    }
+
+    auto tmpFileName = m_fileName + ".tmp";
+    std::ofstream ofs(tmpFileName, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("failed to create cache file " + tmpFileName);
+    }
+    static const char padding[8] = {};
+    auto pad = [&ofs]() {
+        auto pos = static_cast<std::size_t>(ofs.tellp());
+        ofs.write(padding, align8(pos) - pos);
+    };
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(m_fingerprint.data(), m_fingerprint.size());
+    pad();
+    ofs.write(reinterpret_cast<const char *>(index.data()), index.size() * sizeof(index_t));
+    pad();
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (items[i].vector != nullptr) {
+            const auto &v = *items[i].vector;
+            cacheRecord_t record {};
+            std::memcpy(&record, items[i].record, sizeof(record));
+            auto tail = sizeof(record) + record.vectorSize * sizeof(float);
+            record.vectorSize = static_cast<uint16_t>(v.size());
+            ofs.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            ofs.write(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(float));
+            ofs.write(reinterpret_cast<const char *>(items[i].record) + tail, items[i].length - tail);
+        } else {
+            ofs.write(reinterpret_cast<const char *>(items[i].record), items[i].length);
+        }
+        pad();
+    }
+    ofs.close();
+    if (!ofs) {
+        std::remove(tmpFileName.c_str());
+        throw std::runtime_error("failed to write cache file " + tmpFileName);
+    }
+    // the old file stays mapped till the cache is destroyed
+    if (std::rename(tmpFileName.c_str(), m_fileName.c_str()) != 0) {
+        std::remove(tmpFileName.c_str());
+        throw std::runtime_error("failed to replace cache file " + m_fileName);
+    }
+}
+
+docCache_t::stat_t docCache_t::stat() const noexcept {
+    stat_t ret;
+    ret.hits = m_hits.load(std::memory_order_relaxed);
+    ret.misses = m_misses.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lck(m_mtx);
+    ret.vectorHits = m_vectorHits;
+    ret.vectorMisses = m_vectorMisses;
+
+    return ret;
+}
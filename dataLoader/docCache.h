@@ -0,0 +1,126 @@
+/**
+ * @file dataLoader/docCache.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_DOCCACHE_H
+#define TGNEWS_DOCCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+#include "types.h"
+
+// Content addressed cache of parsed documents, their language codes and embedding vectors, kept between CLI runs.
+// Entries are keyed by a hash and a size of the HTML file content. The cache file is memory mapped and searched in
+// place. New records are spilled to an unlinked journal file next to the cache, their keys, offsets and the vectors
+// added by this run are kept in memory; save() copies the records from the journal to the new cache file together
+// with the old ones.
+// The cache is dropped if the fingerprint (models, parser settings) does not match the one it was written with.
+class docCache_t final {
+public:
+    // max entries written by save(), entries used by the current run are preferred
+    static const std::size_t maxEntries = 4 * 1024 * 1024;
+
+    struct contentKey_t {
+        uint64_t hash = 0;
+        uint64_t size = 0;
+
+        bool operator==(const contentKey_t &_r) const noexcept {return (hash == _r.hash) && (size == _r.size);}
+        bool operator<(const contentKey_t &_r) const noexcept {
+            return (hash < _r.hash) || ((hash == _r.hash) && (size < _r.size));
+        }
+    };
+
+    // lookup statistics
+    struct stat_t {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t vectorHits = 0;
+        uint64_t vectorMisses = 0;
+    };
+
+    docCache_t(std::string _fileName, std::string _fingerprint);
+    ~docCache_t();
+
+    docCache_t(const docCache_t &) = delete;
+    void operator=(const docCache_t &) = delete;
+
+    // model file names with their sizes and modification times and the _settings string
+    static std::string fingerprint(const std::vector<std::string> &_files, const std::string &_settings);
+    static contentKey_t key(const uint8_t *_data, std::size_t _size) noexcept;
+
+    // fills the document fields (but name) and the language code, empty language code means the document has no
+    // text or was not parsed; binds the file name to the key. Thread safe.
+    bool lookup(const std::string &_fileName, const contentKey_t &_key, document_t &_document, std::string &_langCode);
+    // adds the parsed document and binds the file name to the key. Thread safe.
+    void insert(const std::string &_fileName,
+                const contentKey_t &_key,
+                const document_t &_document,
+                const std::string &_langCode);
+
+    // copies the _size floats embedding vector of the bound file to _vector, vectors of other sizes are not found.
+    // Not thread safe, the cache must not be modified meanwhile.
+    bool lookupVector(const std::string &_fileName, float *_vector, std::size_t _size);
+    // adds the embedding vector of the bound file. Thread safe.
+    void insertVector(const std::string &_fileName, const float *_vector, std::size_t _size);
+
+    // writes the cache file, old entries are kept
+    void save();
+
+    [[nodiscard]] stat_t stat() const noexcept;
+
+private:
+    struct keyHash_t {
+        std::size_t operator()(const contentKey_t &_key) const noexcept {return _key.hash ^ _key.size;}
+    };
+    struct index_t;
+    struct entry_t {
+        document_t document;
+        std::string langCode;
+        std::vector<float> vector;
+    };
+    // a journal record or, if index is set, a record of the cache file; the vector replaces the one of the record
+    struct newEntry_t {
+        const index_t *index = nullptr;
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        std::vector<float> vector;
+    };
+
+    const std::string m_fileName;
+    const std::string m_fingerprint;
+
+    // the cache file
+    const uint8_t *m_data = nullptr;
+    std::size_t m_size = 0;
+    const index_t *m_index = nullptr;
+    std::size_t m_entries = 0;
+    std::vector<std::atomic<bool>> m_used;
+
+    // the journal
+    int m_journal = -1;
+    uint64_t m_journalSize = 0;
+
+    std::unordered_map<contentKey_t, newEntry_t, keyHash_t> m_new;
+    std::unordered_map<std::string, contentKey_t> m_files;
+    mutable std::mutex m_mtx;
+
+    std::atomic<uint64_t> m_hits {0};
+    std::atomic<uint64_t> m_misses {0};
+    uint64_t m_vectorHits = 0;
+    uint64_t m_vectorMisses = 0;
+
+    void load();
+    [[nodiscard]] const index_t *find(const contentKey_t &_key) const noexcept;
+    static bool decode(const uint8_t *_data, std::size_t _size, uint64_t _offset, uint64_t _length,
+                       entry_t &_entry, bool _vector);
+};
+
+#endif //TGNEWS_DOCCACHE_H
@@ -5,35 +5,173 @@
  * @date 02.12.2019
 */
 
-#include <fts.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 
-#include <stdexcept>
+#include <cstring>
+#include <thread>
 
 #include "fileEnumerator.h"
 
-const std::vector<std::pair<std::string, std::string>> &fileEnumerator_t::operator()(char  *const *_path) {
-    m_fileList.clear();
+fileEnumerator_t::fileEnumerator_t(uint8_t _threads, std::size_t _batchSize) noexcept:
+        m_threads((_threads == 0)?1:_threads), m_batchSize((_batchSize == 0)?1:_batchSize) {
+}
+
+void fileEnumerator_t::operator()(char *const *_path, const consumer_t &_consumer) {
+    m_dirs.clear();
+    m_pending = 0;
+    m_stop = false;
+    m_error = nullptr;
 
-    auto fileSystem = fts_open(_path, FTS_COMFOLLOW | FTS_NOCHDIR, nullptr);
-    if (fileSystem == nullptr) {
-        throw std::runtime_error("Failed to open specified source path");
+    fileBatch_t batch;
+    for (auto path = _path; *path != nullptr; ++path) {
+        std::string name(*path);
+        while ((name.length() > 1) && (name.back() == '/')) {
+            name.pop_back();
+        }
+        // the specified paths are followed
+        struct stat st {};
+        if ((::stat(name.c_str(), &st) == 0) && S_ISDIR(st.st_mode)) {
+            if (name.back() != '/') {
+                name += '/';
+            }
+            m_dirs.emplace_back(std::move(name));
+        } else {
+            batch.emplace_back(std::string(), *path);
+        }
+    }
+    m_pending = m_dirs.size();
+    if (!batch.empty()) {
+        _consumer(std::move(batch));
+    }
+    if (m_dirs.empty()) {
+        return;
     }
 
-    FTSENT *parent = nullptr;
-    while (true) {
-        auto child = fts_children(fileSystem, 0);
-        while (child != nullptr) {
-            if (child->fts_info & FTS_F) {
-                m_fileList.emplace_back(std::pair<std::string, std::string>(child->fts_path, child->fts_name));
+    std::vector<std::thread> thrPool;
+    for (int i = 0; i < m_threads; ++i) {
+        thrPool.emplace_back(std::thread(&fileEnumerator_t::worker, this, std::cref(_consumer)));
+    }
+    for (auto &i:thrPool) {
+        i.join();
+    }
+
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void fileEnumerator_t::worker(const consumer_t &_consumer) noexcept {
+    try {
+        std::vector<char> buffer(direntBufferSize);
+        fileBatch_t batch;
+        while (true) {
+            std::string dir;
+            {
+                std::unique_lock<std::mutex> lck(m_mtx);
+                if (m_dirs.empty() && !batch.empty()) {
+                    // nothing to walk right now, let consumers start with files found so far
+                    lck.unlock();
+                    _consumer(std::move(batch));
+                    batch = fileBatch_t();
+                    lck.lock();
+                }
+                m_cv.wait(lck, [this] {return m_stop || !m_dirs.empty() || (m_pending == 0);});
+                if (m_stop || m_dirs.empty()) {
+                    break;
+                }
+                // LIFO order keeps the queue short on deep trees
+                dir = std::move(m_dirs.back());
+                m_dirs.pop_back();
             }
-            child = child->fts_link;
+
+            walk(dir, buffer, batch, _consumer);
+
+            std::unique_lock<std::mutex> lck(m_mtx);
+            if (--m_pending == 0) {
+                m_cv.notify_all();
+            }
+        }
+        if (!batch.empty()) {
+            _consumer(std::move(batch));
         }
-        parent = fts_read(fileSystem);
-        if (parent == nullptr) {
-            break;
+    } catch (...) {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        if (!m_error) {
+            m_error = std::current_exception();
         }
+        m_stop = true;
+        m_cv.notify_all();
     }
-    fts_close(fileSystem);
+}
+
+void fileEnumerator_t::walk(const std::string &_dir,
+                            std::vector<char> &_buffer,
+                            fileBatch_t &_batch,
+                            const consumer_t &_consumer) {
+    auto fd = ::openat(AT_FDCWD, _dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) { // unreadable directories are skipped
+        return;
+    }
+
+    std::vector<std::string> subDirs;
+    try {
+        while (true) {
+            auto size = ::syscall(SYS_getdents64, fd, _buffer.data(), _buffer.size());
+            if (size <= 0) {
+                break;
+            }
 
-    return m_fileList;
+            for (long pos = 0; pos < size;) {
+                auto entry = reinterpret_cast<const struct dirent64 *>(_buffer.data() + pos);
+                pos += entry->d_reclen;
+
+                const char *name = entry->d_name;
+                if ((std::strcmp(name, ".") == 0) || (std::strcmp(name, "..") == 0)) {
+                    continue;
+                }
+                auto type = entry->d_type;
+                if (type == DT_UNKNOWN) { // not all file systems fill d_type
+                    struct stat st {};
+                    if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                        continue;
+                    }
+                    if (S_ISDIR(st.st_mode)) {
+                        type = DT_DIR;
+                    } else if (S_ISREG(st.st_mode)) {
+                        type = DT_REG;
+                    } else if (S_ISLNK(st.st_mode)) {
+                        type = DT_LNK;
+                    }
+                }
+
+                if (type == DT_DIR) {
+                    subDirs.emplace_back(_dir + name + '/');
+                } else if ((type == DT_REG) || (type == DT_LNK)) {
+                    _batch.emplace_back(_dir, name);
+                    if (_batch.size() >= m_batchSize) {
+                        _consumer(std::move(_batch));
+                        _batch = fileBatch_t();
+                    }
+                }
+            }
+
+            if (!subDirs.empty()) {
+                std::unique_lock<std::mutex> lck(m_mtx);
+                m_pending += subDirs.size();
+                for (auto &i:subDirs) {
+                    m_dirs.emplace_back(std::move(i));
+                }
+                m_cv.notify_all();
+                subDirs.clear();
+            }
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
 }
@@ -8,15 +8,46 @@
 #ifndef TGNEWS_FILEENUMERATOR_H
 #define TGNEWS_FILEENUMERATOR_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
+// Parallel directory walker. Subdirectories are read by a pool of threads, found files are passed to the consumer
+// in batches while the walk is still in progress.
 class fileEnumerator_t final {
+public:
+    // path (with trailing '/') and file name
+    using fileBatch_t = std::vector<std::pair<std::string, std::string>>;
+    // called concurrently by walker threads
+    using consumer_t = std::function<void(fileBatch_t &&_batch)>;
+
+    // getdents64 buffer size, large buffers save syscalls on network file systems
+    static const std::size_t direntBufferSize = 64 * 1024;
+
+    fileEnumerator_t(uint8_t _threads, std::size_t _batchSize) noexcept;
+
+    // regular files and symbolic links are enumerated, directory symlinks are not followed except the specified paths
+    void operator()(char *const *_path, const consumer_t &_consumer);
+
 private:
-    std::vector<std::pair<std::string, std::string>> m_fileList;
+    const uint8_t m_threads;
+    const std::size_t m_batchSize;
 
-public:
-    const std::vector<std::pair<std::string, std::string>> &operator()(char  *const *_path);
+    // directories to walk, with trailing '/'
+    std::vector<std::string> m_dirs;
+    // queued directories and directories being walked
+    std::size_t m_pending = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+
+    void worker(const consumer_t &_consumer) noexcept;
+    void walk(const std::string &_dir, std::vector<char> &_buffer, fileBatch_t &_batch, const consumer_t &_consumer);
 };
 
 #endif //TGNEWS_FILEENUMERATOR_H
@@ -0,0 +1,116 @@
+/**
+ * @file dataLoader/fileReadBench.cpp
+ * @brief input file loading by one thread: blocking mmap/read against io_uring, on a warm and a cold page cache
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "mappedFile.h"
+#include "dataLoader.h"
+
+using inputBatch_t = dataLoader_t::inputBatch_t;
+
+// drops cached pages of the files; dirty pages and pages mapped by other processes stay in the cache
+static void dropCache(const std::vector<inputBatch_t> &_batches) {
+    for (const auto &b:_batches) {
+        for (const auto &f:b.files) {
+            auto fd = ::open((f.first + f.second).c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+            ::fdatasync(fd);
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+    }
+}
+
+struct run_t {
+    double ms = 0.0;
+    dataLoader_t::loadStat_t stat;
+};
+
+// loads all batches as the loading workers do, every byte is touched as the parser does
+static run_t load(const std::vector<inputBatch_t> &_batches, uringReader_t *_reader, uint64_t &_sum) {
+    run_t ret;
+    mappedFile_t file;
+    auto started = std::chrono::steady_clock::now();
+    for (const auto &b:_batches) {
+        dataLoader_t::loadFiles(b, _reader, file, ret.stat,
+                                [&_sum](std::size_t, const uint8_t *_data, std::size_t _size) {
+            for (std::size_t i = 0; i < _size; ++i) {
+                _sum += _data[i];
+            }
+        });
+    }
+    ret.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " html_dir [repeats]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int repeats = (argc > 2)?std::atoi(argv[2]):3;
+    if (repeats <= 0) {
+        repeats = 1;
+    }
+
+    std::vector<inputBatch_t> batches;
+    char *paths[] = {argv[1], nullptr};
+    dataLoader_t::enumerate(1, dataLoader_t::fileBatchSize, paths, [&batches](inputBatch_t &&_batch) {
+        batches.emplace_back(std::move(_batch));
+    });
+    if (batches.empty()) {
+        std::cerr << "no files found" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uringReader_t reader;
+    if (!reader.available()) {
+        std::cerr << "io_uring is not available, only the blocking path is measured" << std::endl;
+    }
+
+    uint64_t sum = 0;
+    // page cache is populated for the warm runs
+    load(batches, nullptr, sum);
+    std::cout << std::fixed << std::setprecision(0);
+    for (auto cold:{false, true}) {
+        for (auto uring:{false, true}) {
+            if (uring && !reader.available()) {
+                continue;
+            }
+            double minMs = 0.0;
+            double maxMs = 0.0;
+            run_t run;
+            for (int i = 0; i < repeats; ++i) {
+                if (cold) {
+                    dropCache(batches);
+                }
+                run = load(batches, uring?&reader:nullptr, sum);
+                minMs = (i == 0)?run.ms:std::min(minMs, run.ms);
+                maxMs = std::max(maxMs, run.ms);
+            }
+            std::cout << (cold?"cold":"warm") << " cache, " << (uring?"io_uring":"blocking") << ": "
+                      << minMs << "-" << maxMs << " ms, " << run.stat.files << " files, "
+                      << run.stat.bytes / (1024 * 1024) << " MB, " << run.stat.mapped << " mapped, "
+                      << run.stat.syscalls << " syscalls" << std::endl;
+        }
+    }
+    std::cout << "checksum " << sum << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file dataLoader/gumboArena.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+
+#include "gumboArena.h"
+
+std::atomic<std::size_t> gumboArena_t::m_peakHighWaterMark{0};
+std::atomic<std::size_t> gumboArena_t::m_overflows{0};
+
+gumboArena_t::gumboArena_t() noexcept: m_options(kGumboDefaultOptions) {
+    m_options.allocator = allocator;
+    m_options.deallocator = deallocator;
+    m_options.userdata = this;
+}
+
+gumboArena_t::~gumboArena_t() {
+    reset();
+    while (m_free != nullptr) {
+        auto next = m_free->next;
+        std::free(m_free);
+        m_free = next;
+    }
+}
+
+void gumboArena_t::reset() noexcept {
+    if (m_treeHighWaterMark > m_highWaterMark) {
+        m_highWaterMark = m_treeHighWaterMark;
+        auto peak = m_peakHighWaterMark.load(std::memory_order_relaxed);
+        while ((peak < m_highWaterMark)
+               && !m_peakHighWaterMark.compare_exchange_weak(peak, m_highWaterMark, std::memory_order_relaxed)) {
+        }
+    }
+
+    if (m_overflowed) {
+        m_overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+    while (m_overflow != nullptr) {
+        auto next = m_overflow->next;
+        std::free(m_overflow);
+        m_overflow = next;
+    }
+
+    // regular blocks are kept up to the retained size limit, oversized ones are always released
+    while (m_blocks != nullptr) {
+        auto next = m_blocks->next;
+        if ((m_blocks->size == blockSize) && (m_retained + blockSize <= maxRetainedSize)) {
+            m_blocks->next = m_free;
+            m_free = m_blocks;
+            m_retained += blockSize;
+        } else {
+            std::free(m_blocks);
+        }
+        m_blocks = next;
+    }
+
+    std::fill(std::begin(m_freeChunks), std::end(m_freeChunks), nullptr);
+    m_pos = nullptr;
+    m_end = nullptr;
+    m_treeSize = 0;
+    m_overflowed = false;
+    m_used = 0;
+    m_treeHighWaterMark = 0;
+}
+
+void *gumboArena_t::allocate(std::size_t _size) noexcept {
+    auto chunkClass = sizeClass(_size);
+    if (chunkClass >= sizeClasses) {
+        return allocateOverflow(_size);
+    }
+    auto size = chunkSize(chunkClass);
+
+    auto chunk = m_freeChunks[chunkClass];
+    if (chunk != nullptr) {
+        m_freeChunks[chunkClass] = chunk->next;
+    } else {
+        if ((static_cast<std::size_t>(m_end - m_pos) < size) && !newBlock(size)) {
+            return allocateOverflow(_size);
+        }
+        chunk = reinterpret_cast<chunk_t *>(m_pos);
+        m_pos += size;
+        chunk->sizeClass = chunkClass;
+    }
+    chunk->next = nullptr;
+
+    m_used += size;
+    m_treeHighWaterMark = std::max(m_treeHighWaterMark, m_used);
+
+    return chunk + 1;
+}
+
+void *gumboArena_t::allocateOverflow(std::size_t _size) noexcept {
+    auto size = sizeof(overflow_t) + sizeof(chunk_t) + _size;
+    auto overflow = static_cast<overflow_t *>(std::malloc(size));
+    if (overflow == nullptr) {
+        return nullptr;
+    }
+    overflow->prev = nullptr;
+    overflow->next = m_overflow;
+    overflow->size = size;
+    if (m_overflow != nullptr) {
+        m_overflow->prev = overflow;
+    }
+    m_overflow = overflow;
+
+    auto chunk = reinterpret_cast<chunk_t *>(overflow + 1);
+    chunk->sizeClass = overflowClass;
+    chunk->next = nullptr;
+
+    m_used += size;
+    m_treeHighWaterMark = std::max(m_treeHighWaterMark, m_used);
+
+    return chunk + 1;
+}
+
+void gumboArena_t::deallocate(void *_ptr) noexcept {
+    if (_ptr == nullptr) {
+        return;
+    }
+
+    auto chunk = static_cast<chunk_t *>(_ptr) - 1;
+    if (chunk->sizeClass == overflowClass) {
+        auto overflow = reinterpret_cast<overflow_t *>(chunk) - 1;
+        if (overflow->prev != nullptr) {
+            overflow->prev->next = overflow->next;
+        } else {
+            m_overflow = overflow->next;
+        }
+        if (overflow->next != nullptr) {
+            overflow->next->prev = overflow->prev;
+        }
+        m_used -= overflow->size;
+        std::free(overflow);
+        return;
+    }
+
+    chunk->next = m_freeChunks[chunk->sizeClass];
+    m_freeChunks[chunk->sizeClass] = chunk;
+    m_used -= chunkSize(chunk->sizeClass);
+}
+
+bool gumboArena_t::newBlock(std::size_t _size) noexcept {
+    auto size = (_size > blockSize)?_size:blockSize;
+    if (m_treeSize + size > maxTreeSize) {
+        m_overflowed = true;
+        return false;
+    }
+
+    block_t *block = nullptr;
+    if ((size == blockSize) && (m_free != nullptr)) {
+        block = m_free;
+        m_free = m_free->next;
+        m_retained -= blockSize;
+    } else {
+        block = static_cast<block_t *>(std::malloc(sizeof(block_t) + size));
+        if (block == nullptr) {
+            return false;
+        }
+        block->size = size;
+    }
+
+    block->next = m_blocks;
+    m_blocks = block;
+    m_pos = reinterpret_cast<char *>(block + 1);
+    m_end = m_pos + block->size;
+    m_treeSize += size;
+
+    return true;
+}
+
+uint32_t gumboArena_t::sizeClass(std::size_t _size) noexcept {
+    auto size = sizeof(chunk_t) + _size;
+    if (size <= smallChunkSize) {
+        return static_cast<uint32_t>((size - 1) / sizeof(chunk_t));
+    }
+
+    auto ret = smallClasses;
+    for (auto chunk = smallChunkSize * 2; (chunk < size) && (ret < sizeClasses); chunk *= 2) {
+        ++ret;
+    }
+
+    return ret;
+}
+
+std::size_t gumboArena_t::chunkSize(uint32_t _sizeClass) noexcept {
+    if (_sizeClass < smallClasses) {
+        return (_sizeClass + 1) * sizeof(chunk_t);
+    }
+
+    return smallChunkSize << (_sizeClass - smallClasses + 1);
+}
+
+void *gumboArena_t::allocator(void *_arena, std::size_t _size) {
+    return static_cast<gumboArena_t *>(_arena)->allocate(_size);
+}
+
+void gumboArena_t::deallocator(void *_arena, void *_ptr) {
+    static_cast<gumboArena_t *>(_arena)->deallocate(_ptr);
+}
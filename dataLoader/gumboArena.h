@@ -0,0 +1,108 @@
+/**
+ * @file dataLoader/gumboArena.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_GUMBOARENA_H
+#define TGNEWS_GUMBOARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <gumbo.h>
+
+// Arena for Gumbo parse trees. Chunks are carved from large blocks and rounded up to a size class, freed chunks
+// (buffers superseded by a grown copy, temporaries) go to a free list of their class and are reused within the tree.
+// The whole tree is dropped by reset(), so gumbo_destroy_output() is not needed.
+// Blocks of a single tree are limited by maxTreeSize. Gumbo can not fail an allocation, so once the limit is reached
+// the rest of the tree is allocated by malloc and freed one by one, as with the default options.
+// The arena is not thread safe, use one arena per thread.
+class gumboArena_t final {
+public:
+    static const std::size_t blockSize = 256 * 1024;
+    // memory kept between documents, blocks allocated for larger trees are released by reset()
+    static const std::size_t maxRetainedSize = 4 * 1024 * 1024;
+    // max size of blocks allocated for a single tree
+    static const std::size_t maxTreeSize = 32 * 1024 * 1024;
+
+    gumboArena_t() noexcept;
+    ~gumboArena_t();
+
+    gumboArena_t(const gumboArena_t &) = delete;
+    void operator=(const gumboArena_t &) = delete;
+
+    [[nodiscard]] const GumboOptions *options() const noexcept {return &m_options;}
+
+    // drops everything allocated since the previous reset
+    void reset() noexcept;
+
+    // max bytes in use by a single tree, by this arena and by all arenas of the process
+    [[nodiscard]] std::size_t highWaterMark() const noexcept {return m_highWaterMark;}
+    static std::size_t peakHighWaterMark() noexcept {return m_peakHighWaterMark.load(std::memory_order_relaxed);}
+    // trees that reached maxTreeSize, by all arenas of the process
+    static std::size_t overflows() noexcept {return m_overflows.load(std::memory_order_relaxed);}
+
+private:
+    struct alignas(alignof(std::max_align_t)) block_t {
+        block_t *next = nullptr;
+        std::size_t size = 0;
+    };
+
+    // precedes every allocation
+    struct alignas(alignof(std::max_align_t)) chunk_t {
+        uint32_t sizeClass = 0;
+        // next free chunk of the same size class
+        chunk_t *next = nullptr;
+    };
+
+    // precedes the chunk of an allocation made by malloc after maxTreeSize is reached
+    struct alignas(alignof(std::max_align_t)) overflow_t {
+        overflow_t *prev = nullptr;
+        overflow_t *next = nullptr;
+        std::size_t size = 0;
+    };
+
+    // chunks up to smallChunkSize are rounded up to sizeof(chunk_t), larger ones to a power of two
+    static const std::size_t smallChunkSize = 1024;
+    static const uint32_t smallClasses = smallChunkSize / sizeof(chunk_t);
+    static const uint32_t sizeClasses = smallClasses + 40;
+    static const uint32_t overflowClass = sizeClasses;
+
+    GumboOptions m_options;
+    // blocks in use, the current one is the first
+    block_t *m_blocks = nullptr;
+    // retained empty blocks
+    block_t *m_free = nullptr;
+    // free chunks by size class
+    chunk_t *m_freeChunks[sizeClasses] = {};
+    // allocations made by malloc after maxTreeSize is reached
+    overflow_t *m_overflow = nullptr;
+    char *m_pos = nullptr;
+    char *m_end = nullptr;
+    std::size_t m_retained = 0;
+    // blocks of the current tree
+    std::size_t m_treeSize = 0;
+    bool m_overflowed = false;
+    // bytes of the current tree in use, freed chunks are not counted
+    std::size_t m_used = 0;
+    std::size_t m_treeHighWaterMark = 0;
+    std::size_t m_highWaterMark = 0;
+
+    static std::atomic<std::size_t> m_peakHighWaterMark;
+    static std::atomic<std::size_t> m_overflows;
+
+    void *allocate(std::size_t _size) noexcept;
+    void deallocate(void *_ptr) noexcept;
+    void *allocateOverflow(std::size_t _size) noexcept;
+    bool newBlock(std::size_t _size) noexcept;
+
+    static uint32_t sizeClass(std::size_t _size) noexcept;
+    static std::size_t chunkSize(uint32_t _sizeClass) noexcept;
+
+    static void *allocator(void *_arena, std::size_t _size);
+    static void deallocator(void *_arena, void *_ptr);
+};
+
+#endif //TGNEWS_GUMBOARENA_H
@@ -0,0 +1,970 @@
+/**
+ * @file dataLoader/htmlScanner.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "textExtractor.h"
+#include "htmlScanner.h"
+
+static inline bool isSpace(char _c) noexcept {
+    return (_c == ' ') || (_c == '\t') || (_c == '\n') || (_c == '\f') || (_c == '\r');
+}
+
+static inline bool isAlpha(char _c) noexcept {
+    return ((_c | 0x20) >= 'a') && ((_c | 0x20) <= 'z');
+}
+
+static inline bool isDigit(char _c) noexcept {
+    return (_c >= '0') && (_c <= '9');
+}
+
+static inline char toLower(char _c) noexcept {
+    return ((_c >= 'A') && (_c <= 'Z'))?static_cast<char>(_c | 0x20):_c;
+}
+
+bool htmlScanner_t::operator()(const char *_html, std::size_t _size, document_t &_data, std::string &_text) {
+    m_html = _html;
+    m_size = _size;
+    m_pos = 0;
+    m_stack.clear();
+    m_pending.clear();
+    m_slots.clear();
+    m_openSlots.clear();
+    m_collectors = 0;
+    m_titleCollector = false;
+    m_timeCollector = false;
+    m_skipNewLine = false;
+
+    while (m_pos < m_size) {
+        if ((m_html[m_pos] != '<') || (m_pos + 1 >= m_size)) {
+            if (!text()) {
+                return false;
+            }
+            continue;
+        }
+
+        auto c = m_html[m_pos + 1];
+        if (isAlpha(c)) {
+            m_skipNewLine = false;
+            if (!startTag(_data, _text)) {
+                return false;
+            }
+        } else if (c == '/') {
+            m_skipNewLine = false;
+            if ((m_pos + 2 < m_size) && isAlpha(m_html[m_pos + 2])) {
+                if (!endTag(_data, _text)) {
+                    return false;
+                }
+            } else if ((m_pos + 2 >= m_size) || (m_html[m_pos + 2] == '>')) { // ignored by tokenizer
+                return false;
+            } else if (!flush(_data, _text) || !skipUntil('>')) { // bogus comment
+                return false;
+            }
+        } else if (c == '!') {
+            m_skipNewLine = false;
+            if ((m_pos + 3 < m_size) && (m_html[m_pos + 2] == '-') && (m_html[m_pos + 3] == '-')) {
+                if (!flush(_data, _text) || !skipComment()) {
+                    return false;
+                }
+            } else if ((m_size - m_pos > 9) && (strncasecmp(m_html + m_pos + 2, "doctype", 7) == 0)) {
+                // DOCTYPE is ignored by tree builder and does not split text nodes
+                if (collecting() || !skipUntil('>')) {
+                    return false;
+                }
+            } else if (!flush(_data, _text) || !skipUntil('>')) { // bogus comment
+                return false;
+            }
+        } else if (c == '?') {
+            m_skipNewLine = false;
+            if (!flush(_data, _text) || !skipUntil('>')) { // bogus comment
+                return false;
+            }
+        } else if (!text()) {
+            return false;
+        }
+    }
+
+    if (!flush(_data, _text)) {
+        return false;
+    }
+    while (!m_stack.empty()) {
+        auto element = m_stack.back();
+        m_stack.pop_back();
+        close(element, _data, _text);
+    }
+
+    return true;
+}
+
+htmlScanner_t::tag_t htmlScanner_t::tag(std::string_view _name) noexcept {
+    static const std::unordered_map<std::string_view, tag_t> tags {
+            {"p", tag_t::P},
+            {"li", tag_t::LI},
+            {"h1", tag_t::H1},
+            {"h2", tag_t::HN},
+            {"h3", tag_t::HN},
+            {"h4", tag_t::HN},
+            {"h5", tag_t::HN},
+            {"h6", tag_t::HN},
+            {"time", tag_t::TIME},
+            {"meta", tag_t::META},
+            {"pre", tag_t::PRE},
+            {"listing", tag_t::PRE},
+            {"ul", tag_t::LIST},
+            {"ol", tag_t::LIST},
+            {"menu", tag_t::LIST},
+            {"dl", tag_t::DL},
+            {"dd", tag_t::DD},
+            {"dt", tag_t::DD},
+            {"a", tag_t::A},
+            {"nobr", tag_t::NOBR},
+            {"button", tag_t::BUTTON},
+            {"form", tag_t::FORM},
+            {"option", tag_t::OPTION},
+            {"optgroup", tag_t::OPTION},
+            {"noscript", tag_t::NOSCRIPT},
+            {"script", tag_t::SCRIPT},
+            {"style", tag_t::RAWTEXT},
+            {"iframe", tag_t::RAWTEXT},
+            {"noembed", tag_t::RAWTEXT},
+            {"noframes", tag_t::RAWTEXT},
+            {"xmp", tag_t::XMP},
+            {"title", tag_t::RCDATA},
+            {"area", tag_t::VOID},
+            {"base", tag_t::VOID},
+            {"basefont", tag_t::VOID},
+            {"bgsound", tag_t::VOID},
+            {"br", tag_t::VOID},
+            {"embed", tag_t::VOID},
+            {"img", tag_t::VOID},
+            {"image", tag_t::VOID},
+            {"input", tag_t::VOID},
+            {"keygen", tag_t::VOID},
+            {"link", tag_t::VOID},
+            {"param", tag_t::VOID},
+            {"source", tag_t::VOID},
+            {"track", tag_t::VOID},
+            {"wbr", tag_t::VOID},
+            {"hr", tag_t::HR},
+            {"address", tag_t::BLOCK},
+            {"article", tag_t::BLOCK},
+            {"aside", tag_t::BLOCK},
+            {"blockquote", tag_t::BLOCK},
+            {"center", tag_t::BLOCK},
+            {"details", tag_t::BLOCK},
+            {"dialog", tag_t::BLOCK},
+            {"dir", tag_t::BLOCK},
+            {"div", tag_t::BLOCK},
+            {"fieldset", tag_t::BLOCK},
+            {"figcaption", tag_t::BLOCK},
+            {"figure", tag_t::BLOCK},
+            {"footer", tag_t::BLOCK},
+            {"header", tag_t::BLOCK},
+            {"hgroup", tag_t::BLOCK},
+            {"main", tag_t::BLOCK},
+            {"nav", tag_t::BLOCK},
+            {"search", tag_t::BLOCK},
+            {"section", tag_t::BLOCK},
+            {"summary", tag_t::BLOCK},
+            {"html", tag_t::STRUCTURE},
+            {"head", tag_t::STRUCTURE},
+            {"body", tag_t::STRUCTURE},
+            {"table", tag_t::UNSUPPORTED},
+            {"caption", tag_t::UNSUPPORTED},
+            {"col", tag_t::UNSUPPORTED},
+            {"colgroup", tag_t::UNSUPPORTED},
+            {"tbody", tag_t::UNSUPPORTED},
+            {"thead", tag_t::UNSUPPORTED},
+            {"tfoot", tag_t::UNSUPPORTED},
+            {"tr", tag_t::UNSUPPORTED},
+            {"td", tag_t::UNSUPPORTED},
+            {"th", tag_t::UNSUPPORTED},
+            {"select", tag_t::UNSUPPORTED},
+            {"textarea", tag_t::UNSUPPORTED},
+            {"plaintext", tag_t::UNSUPPORTED},
+            {"isindex", tag_t::UNSUPPORTED},
+            {"menuitem", tag_t::UNSUPPORTED},
+            {"svg", tag_t::FOREIGN},
+            {"math", tag_t::FOREIGN},
+            {"template", tag_t::UNSUPPORTED},
+            {"frameset", tag_t::UNSUPPORTED},
+            {"frame", tag_t::UNSUPPORTED},
+            {"rb", tag_t::UNSUPPORTED},
+            {"rp", tag_t::UNSUPPORTED},
+            {"rt", tag_t::UNSUPPORTED},
+            {"rtc", tag_t::UNSUPPORTED}
+    };
+
+    char buffer[16];
+    auto i = tags.find(lower(_name, buffer, sizeof(buffer)));
+
+    return (i != tags.end())?i->second:tag_t::OTHER;
+}
+
+std::string_view htmlScanner_t::lower(std::string_view _name, char *_buffer, std::size_t _size) noexcept {
+    // too long names are not known
+    if (_name.length() >= _size) {
+        return std::string_view();
+    }
+    for (std::size_t i = 0; i < _name.length(); ++i) {
+        _buffer[i] = toLower(_name[i]);
+    }
+
+    return std::string_view(_buffer, _name.length());
+}
+
+bool htmlScanner_t::equal(std::string_view _l, std::string_view _r) noexcept {
+    return (_l.length() == _r.length()) && (strncasecmp(_l.data(), _r.data(), _l.length()) == 0);
+}
+
+bool htmlScanner_t::validUtf8(std::string_view _str) noexcept {
+    std::size_t i = 0;
+    while (i < _str.length()) {
+        auto c = static_cast<uint8_t>(_str[i]);
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        std::size_t length = 0;
+        uint32_t codePoint = 0;
+        uint32_t minCodePoint = 0;
+        if ((c & 0xe0) == 0xc0) {
+            length = 2;
+            codePoint = c & 0x1fu;
+            minCodePoint = 0x80;
+        } else if ((c & 0xf0) == 0xe0) {
+            length = 3;
+            codePoint = c & 0x0fu;
+            minCodePoint = 0x800;
+        } else if ((c & 0xf8) == 0xf0) {
+            length = 4;
+            codePoint = c & 0x07u;
+            minCodePoint = 0x10000;
+        } else {
+            return false;
+        }
+        if (i + length > _str.length()) {
+            return false;
+        }
+        for (std::size_t j = 1; j < length; ++j) {
+            auto cc = static_cast<uint8_t>(_str[i + j]);
+            if ((cc & 0xc0) != 0x80) {
+                return false;
+            }
+            codePoint = (codePoint << 6u) | (cc & 0x3fu);
+        }
+        if ((codePoint < minCodePoint) || (codePoint > 0x10ffff)
+            || ((codePoint >= 0xd800) && (codePoint <= 0xdfff))) {
+            return false;
+        }
+        i += length;
+    }
+
+    return true;
+}
+
+void htmlScanner_t::appendUtf8(uint32_t _codePoint, std::string &_str) {
+    if (_codePoint < 0x80) {
+        _str += static_cast<char>(_codePoint);
+    } else if (_codePoint < 0x800) {
+        _str += static_cast<char>(0xc0 | (_codePoint >> 6u));
+        _str += static_cast<char>(0x80 | (_codePoint & 0x3fu));
+    } else if (_codePoint < 0x10000) {
+        _str += static_cast<char>(0xe0 | (_codePoint >> 12u));
+        _str += static_cast<char>(0x80 | ((_codePoint >> 6u) & 0x3fu));
+        _str += static_cast<char>(0x80 | (_codePoint & 0x3fu));
+    } else {
+        _str += static_cast<char>(0xf0 | (_codePoint >> 18u));
+        _str += static_cast<char>(0x80 | ((_codePoint >> 12u) & 0x3fu));
+        _str += static_cast<char>(0x80 | ((_codePoint >> 6u) & 0x3fu));
+        _str += static_cast<char>(0x80 | (_codePoint & 0x3fu));
+    }
+}
+
+void htmlScanner_t::append(const std::string &_src, std::string &_dst) {
+    // the same way textExtractor_t::getText joins text nodes
+    if (!_dst.empty()) {
+        _dst += ' ';
+    }
+    _dst += _src;
+}
+
+bool htmlScanner_t::opened(tag_t _tag) const noexcept {
+    for (const auto &e:m_stack) {
+        if (e.tag == _tag) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool htmlScanner_t::text() {
+    if (!collecting()) {
+        // nobody needs this text, skip it
+        auto end = static_cast<const char *>(std::memchr(m_html + m_pos + 1, '<', m_size - m_pos - 1));
+        m_pos = (end != nullptr)?static_cast<std::size_t>(end - m_html):m_size;
+        m_skipNewLine = false;
+        return true;
+    }
+
+    // <pre> start tag eats the first line feed
+    if (m_skipNewLine) {
+        m_skipNewLine = false;
+        if (m_html[m_pos] == '&') {
+            return false;
+        }
+        if (m_html[m_pos] == '\r') {
+            ++m_pos;
+            if ((m_pos < m_size) && (m_html[m_pos] == '\n')) {
+                ++m_pos;
+            }
+        } else if (m_html[m_pos] == '\n') {
+            ++m_pos;
+        }
+    }
+
+    // the first '<' is a text char here
+    auto startFrom = m_pos;
+    if ((m_pos < m_size) && (m_html[m_pos] == '<')) {
+        ++m_pos;
+    }
+    while (m_pos < m_size) {
+        auto c = m_html[m_pos];
+        if (c == '<') {
+            if ((m_pos + 1 < m_size)
+                && (isAlpha(m_html[m_pos + 1]) || (m_html[m_pos + 1] == '/')
+                    || (m_html[m_pos + 1] == '!') || (m_html[m_pos + 1] == '?'))) {
+                break;
+            }
+            ++m_pos;
+        } else if ((c == '&') || (c == '\r') || (c == 0)) {
+            m_pending.append(m_html + startFrom, m_pos - startFrom);
+            if (c == 0) {
+                return false;
+            } else if (c == '\r') {
+                m_pending += '\n';
+                ++m_pos;
+                if ((m_pos < m_size) && (m_html[m_pos] == '\n')) {
+                    ++m_pos;
+                }
+            } else if (!charRef()) {
+                return false;
+            }
+            startFrom = m_pos;
+        } else {
+            ++m_pos;
+        }
+    }
+    m_pending.append(m_html + startFrom, m_pos - startFrom);
+
+    return true;
+}
+
+bool htmlScanner_t::charRef() {
+    // only character references with a known value, legacy references without ';' are not supported
+    static const std::unordered_map<std::string_view, uint32_t> refs {
+            {"amp", 0x26},
+            {"lt", 0x3c},
+            {"gt", 0x3e},
+            {"quot", 0x22},
+            {"apos", 0x27},
+            {"nbsp", 0xa0},
+            {"shy", 0xad},
+            {"laquo", 0xab},
+            {"raquo", 0xbb},
+            {"copy", 0xa9},
+            {"reg", 0xae},
+            {"deg", 0xb0},
+            {"plusmn", 0xb1},
+            {"sect", 0xa7},
+            {"para", 0xb6},
+            {"middot", 0xb7},
+            {"times", 0xd7},
+            {"cent", 0xa2},
+            {"pound", 0xa3},
+            {"yen", 0xa5},
+            {"frac14", 0xbc},
+            {"frac12", 0xbd},
+            {"frac34", 0xbe},
+            {"ensp", 0x2002},
+            {"emsp", 0x2003},
+            {"thinsp", 0x2009},
+            {"zwnj", 0x200c},
+            {"zwj", 0x200d},
+            {"lrm", 0x200e},
+            {"rlm", 0x200f},
+            {"ndash", 0x2013},
+            {"mdash", 0x2014},
+            {"lsquo", 0x2018},
+            {"rsquo", 0x2019},
+            {"sbquo", 0x201a},
+            {"ldquo", 0x201c},
+            {"rdquo", 0x201d},
+            {"bdquo", 0x201e},
+            {"bull", 0x2022},
+            {"hellip", 0x2026},
+            {"euro", 0x20ac},
+            {"trade", 0x2122},
+            {"minus", 0x2212}
+    };
+
+    auto pos = m_pos + 1;
+    if ((pos < m_size) && (m_html[pos] == '#')) {
+        ++pos;
+        bool hex = (pos < m_size) && ((m_html[pos] | 0x20) == 'x');
+        if (hex) {
+            ++pos;
+        }
+        auto startFrom = pos;
+        uint32_t codePoint = 0;
+        while ((pos < m_size) && (pos - startFrom < 7)) {
+            auto c = m_html[pos];
+            if (isDigit(c)) {
+                codePoint = codePoint * (hex?16:10) + (c - '0');
+            } else if (hex && ((c | 0x20) >= 'a') && ((c | 0x20) <= 'f')) {
+                codePoint = codePoint * 16 + ((c | 0x20) - 'a' + 10);
+            } else {
+                break;
+            }
+            ++pos;
+        }
+        if ((pos == startFrom) || (pos >= m_size) || (m_html[pos] != ';')) {
+            return false;
+        }
+        // replaced or remapped by tokenizer
+        if ((codePoint < 0x20 && codePoint != '\t' && codePoint != '\n' && codePoint != '\f')
+            || ((codePoint >= 0x7f) && (codePoint <= 0x9f))
+            || ((codePoint >= 0xd800) && (codePoint <= 0xdfff))
+            || ((codePoint >= 0xfdd0) && (codePoint <= 0xfdef))
+            || ((codePoint & 0xfffeu) == 0xfffeu)
+            || (codePoint > 0x10ffff)) {
+            return false;
+        }
+        appendUtf8(codePoint, m_pending);
+        m_pos = pos + 1;
+
+        return true;
+    }
+
+    auto startFrom = pos;
+    while ((pos < m_size) && (isAlpha(m_html[pos]) || isDigit(m_html[pos]))) {
+        ++pos;
+    }
+    if (pos == startFrom) { // not a character reference
+        m_pending += '&';
+        ++m_pos;
+        return true;
+    }
+    if ((pos >= m_size) || (m_html[pos] != ';')) {
+        return false;
+    }
+    auto i = refs.find(std::string_view(m_html + startFrom, pos - startFrom));
+    if (i == refs.end()) {
+        return false;
+    }
+    appendUtf8(i->second, m_pending);
+    m_pos = pos + 1;
+
+    return true;
+}
+
+bool htmlScanner_t::flush(document_t &_data, std::string &_text) {
+    if (m_pending.empty()) {
+        return true;
+    }
+
+    // Gumbo makes whitespace nodes for whitespace only text, they are ignored
+    bool whitespace = true;
+    for (auto c:m_pending) {
+        if (!isSpace(c)) {
+            whitespace = false;
+            break;
+        }
+    }
+    if (!whitespace && collecting()) {
+        // invalid sequences are replaced by Gumbo
+        if (!validUtf8(m_pending)) {
+            return false;
+        }
+        if (m_collectors > 0) {
+            append(m_pending, _text);
+            for (auto slot:m_openSlots) {
+                append(m_pending, m_slots[slot]);
+            }
+        }
+        if (m_titleCollector) {
+            append(m_pending, _data.title);
+        }
+        if (m_timeCollector) {
+            append(m_pending, m_timeText);
+        }
+    }
+    m_pending.clear();
+
+    return true;
+}
+
+bool htmlScanner_t::tagEnd(bool &_selfClosing) {
+    _selfClosing = false;
+    while (m_pos < m_size) {
+        auto c = m_html[m_pos];
+        if (isSpace(c)) {
+            ++m_pos;
+            continue;
+        }
+        if (c == '>') {
+            ++m_pos;
+            return true;
+        }
+        if (c == '/') {
+            ++m_pos;
+            if ((m_pos < m_size) && (m_html[m_pos] == '>')) {
+                ++m_pos;
+                _selfClosing = true;
+                return true;
+            }
+            continue;
+        }
+
+        // attribute name, the first char may be '='
+        ++m_pos;
+        while ((m_pos < m_size) && !isSpace(m_html[m_pos])
+               && (m_html[m_pos] != '/') && (m_html[m_pos] != '>') && (m_html[m_pos] != '=')) {
+            ++m_pos;
+        }
+        while ((m_pos < m_size) && isSpace(m_html[m_pos])) {
+            ++m_pos;
+        }
+        if ((m_pos >= m_size) || (m_html[m_pos] != '=')) {
+            continue;
+        }
+
+        // attribute value
+        ++m_pos;
+        while ((m_pos < m_size) && isSpace(m_html[m_pos])) {
+            ++m_pos;
+        }
+        if (m_pos >= m_size) {
+            break;
+        }
+        c = m_html[m_pos];
+        if ((c == '"') || (c == '\'')) {
+            auto end = static_cast<const char *>(std::memchr(m_html + m_pos + 1, c, m_size - m_pos - 1));
+            if (end == nullptr) {
+                break;
+            }
+            m_pos = static_cast<std::size_t>(end - m_html) + 1;
+        } else {
+            while ((m_pos < m_size) && !isSpace(m_html[m_pos]) && (m_html[m_pos] != '>')) {
+                ++m_pos;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool htmlScanner_t::startTag(document_t &_data, std::string &_text) {
+    auto tagStart = m_pos;
+    auto nameStart = m_pos + 1;
+    m_pos = nameStart;
+    while ((m_pos < m_size) && !isSpace(m_html[m_pos]) && (m_html[m_pos] != '/') && (m_html[m_pos] != '>')) {
+        ++m_pos;
+    }
+    element_t element;
+    element.name = std::string_view(m_html + nameStart, m_pos - nameStart);
+    element.tag = tag(element.name);
+
+    bool selfClosing = false;
+    if (!tagEnd(selfClosing)) {
+        return false;
+    }
+
+    switch (element.tag) {
+        case tag_t::UNSUPPORTED:
+            return false;
+        case tag_t::STRUCTURE:
+            // merged into existing html/head/body elements, text nodes are not split
+            return !collecting();
+        default:
+            break;
+    }
+
+    // checks for tree builder rules those implicitly close open elements
+    switch (element.tag) {
+        case tag_t::P:
+        case tag_t::H1:
+        case tag_t::HN:
+        case tag_t::PRE:
+        case tag_t::LIST:
+        case tag_t::DL:
+        case tag_t::XMP:
+        case tag_t::FORM:
+        case tag_t::HR:
+        case tag_t::BLOCK:
+        case tag_t::LI:
+        case tag_t::DD:
+            if (opened(tag_t::P)) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    auto top = m_stack.empty()?tag_t::STRUCTURE:m_stack.back().tag;
+    switch (element.tag) {
+        case tag_t::LI:
+            if (top != tag_t::LIST) {
+                return false;
+            }
+            break;
+        case tag_t::DD:
+            if (top != tag_t::DL) {
+                return false;
+            }
+            break;
+        case tag_t::H1:
+        case tag_t::HN:
+            if ((top == tag_t::H1) || (top == tag_t::HN)) {
+                return false;
+            }
+            break;
+        case tag_t::OPTION:
+            if (top == tag_t::OPTION) {
+                return false;
+            }
+            break;
+        case tag_t::A:
+        case tag_t::NOBR:
+        case tag_t::BUTTON:
+        case tag_t::FORM:
+            if (opened(element.tag)) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    // noscript content is not reliable enough
+    switch (element.tag) {
+        case tag_t::P:
+        case tag_t::LI:
+        case tag_t::H1:
+        case tag_t::TIME:
+        case tag_t::META:
+            if (opened(tag_t::NOSCRIPT)) {
+                return false;
+            }
+            break;
+        case tag_t::NOSCRIPT:
+        case tag_t::FOREIGN:
+            if (collecting()) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // a new element splits text nodes
+    if (!flush(_data, _text)) {
+        return false;
+    }
+
+    switch (element.tag) {
+        case tag_t::META: {
+            std::string key;
+            std::string value;
+            if (textExtractor_t::getMeta(std::string_view(m_html + tagStart, m_pos - tagStart), key, value)) {
+                if (key == "og:site_name") {
+                    _data.site = std::move(value);
+                } else if (key == "article:published_time") {
+                    if (m_timeCollector) { // must be applied after the enclosing <time> element
+                        return false;
+                    }
+                    textExtractor_t::str2time(value, _data.time);
+                } else if (key == "og:title") {
+                    if (m_titleCollector) { // must be applied after the enclosing <h1> element
+                        return false;
+                    }
+                    _data.title = std::move(value);
+                }
+            }
+            return true;
+        }
+        case tag_t::VOID:
+        case tag_t::HR:
+            return true;
+        case tag_t::SCRIPT:
+            // script text is ignored, but script data may contain escaped "</script>"
+            return skipRawText(element.name);
+        case tag_t::RAWTEXT:
+            // style text is ignored, other raw text elements are a part of text
+            if (collecting() && !equal(element.name, "style")) {
+                return false;
+            }
+            return skipRawText(element.name);
+        case tag_t::FOREIGN:
+            return selfClosing || skipForeign(element.name);
+        case tag_t::XMP:
+        case tag_t::RCDATA:
+            if (collecting()) {
+                return false;
+            }
+            return skipRawText(element.name);
+        case tag_t::P:
+        case tag_t::LI:
+            element.text = true;
+            if (m_collectors > 0) {
+                element.slot = static_cast<int>(m_slots.size());
+                m_slots.emplace_back();
+                m_openSlots.push_back(element.slot);
+            }
+            ++m_collectors;
+            break;
+        case tag_t::H1:
+            if (!m_titleCollector && _data.title.empty()) {
+                element.title = true;
+                m_titleCollector = true;
+            }
+            break;
+        case tag_t::TIME:
+            if (m_timeCollector) {
+                return false;
+            }
+            if (_data.time == 0) {
+                element.time = true;
+                m_timeCollector = true;
+                m_timeText.clear();
+            }
+            break;
+        case tag_t::PRE:
+            m_skipNewLine = true;
+            break;
+        default:
+            break;
+    }
+    m_stack.push_back(element);
+
+    return true;
+}
+
+bool htmlScanner_t::endTag(document_t &_data, std::string &_text) {
+    auto nameStart = m_pos + 2;
+    m_pos = nameStart;
+    while ((m_pos < m_size) && !isSpace(m_html[m_pos]) && (m_html[m_pos] != '/') && (m_html[m_pos] != '>')) {
+        ++m_pos;
+    }
+    std::string_view name(m_html + nameStart, m_pos - nameStart);
+
+    bool selfClosing = false;
+    if (!tagEnd(selfClosing)) {
+        return false;
+    }
+
+    if (tag(name) == tag_t::STRUCTURE) {
+        return !collecting();
+    }
+    // any other end tag has to close the current element
+    if (m_stack.empty() || !equal(m_stack.back().name, name)) {
+        return false;
+    }
+
+    if (!flush(_data, _text)) {
+        return false;
+    }
+    auto element = m_stack.back();
+    m_stack.pop_back();
+    close(element, _data, _text);
+
+    return true;
+}
+
+bool htmlScanner_t::skipRawText(std::string_view _name) {
+    auto startFrom = m_pos;
+    while (m_pos < m_size) {
+        auto end = static_cast<const char *>(std::memchr(m_html + m_pos, '<', m_size - m_pos));
+        if (end == nullptr) {
+            break;
+        }
+        m_pos = static_cast<std::size_t>(end - m_html);
+        if ((m_pos + 2 + _name.length() < m_size)
+            && (m_html[m_pos + 1] == '/')
+            && equal(std::string_view(m_html + m_pos + 2, _name.length()), _name)) {
+            auto c = m_html[m_pos + 2 + _name.length()];
+            if (isSpace(c) || (c == '/') || (c == '>')) {
+                // script data escape states may hide the end tag
+                if (equal(_name, "script")
+                    && (std::string_view(m_html + startFrom, m_pos - startFrom).find("<!--")
+                        != std::string_view::npos)) {
+                    return false;
+                }
+                m_pos += 2 + _name.length();
+                bool selfClosing = false;
+                return tagEnd(selfClosing);
+            }
+        }
+        ++m_pos;
+    }
+
+    return false;
+}
+
+bool htmlScanner_t::skipForeign(std::string_view _name) {
+    // HTML elements those break out of foreign content
+    static const std::unordered_set<std::string_view> breakouts {
+            "b", "big", "blockquote", "body", "br", "center",
+            "code", "dd", "div", "dl", "dt", "em",
+            "embed", "h1", "h2", "h3", "h4", "h5",
+            "h6", "head", "hr", "i", "img", "li",
+            "listing", "menu", "meta", "nobr", "ol", "p",
+            "pre", "ruby", "s", "small", "span", "strong",
+            "strike", "sub", "sup", "table", "tt", "u",
+            "ul", "var", "font"
+    };
+    // elements those content is parsed as HTML
+    static const std::unordered_set<std::string_view> integrationPoints {
+            "foreignobject", "desc", "title", "mi", "mo",
+            "mn", "ms", "mtext", "annotation-xml"
+    };
+
+    m_foreign.clear();
+    m_foreign.emplace_back(_name);
+    char buffer[16];
+    while (!m_foreign.empty()) {
+        if (!skipUntil('<')) {
+            return false;
+        }
+        --m_pos;
+        if (m_pos + 1 >= m_size) {
+            return false;
+        }
+
+        auto c = m_html[m_pos + 1];
+        if (c == '/') {
+            auto nameStart = m_pos + 2;
+            m_pos = nameStart;
+            while ((m_pos < m_size) && !isSpace(m_html[m_pos]) && (m_html[m_pos] != '/') && (m_html[m_pos] != '>')) {
+                ++m_pos;
+            }
+            std::string_view name(m_html + nameStart, m_pos - nameStart);
+            bool selfClosing = false;
+            if (!tagEnd(selfClosing)) {
+                return false;
+            }
+            if (!equal(m_foreign.back(), name)) {
+                return false;
+            }
+            m_foreign.pop_back();
+        } else if (isAlpha(c)) {
+            if ((m_foreign.size() > 1)
+                && (integrationPoints.count(lower(m_foreign.back(), buffer, sizeof(buffer))) > 0)) {
+                return false;
+            }
+            auto nameStart = m_pos + 1;
+            m_pos = nameStart;
+            while ((m_pos < m_size) && !isSpace(m_html[m_pos]) && (m_html[m_pos] != '/') && (m_html[m_pos] != '>')) {
+                ++m_pos;
+            }
+            std::string_view name(m_html + nameStart, m_pos - nameStart);
+            if (breakouts.count(lower(name, buffer, sizeof(buffer))) > 0) {
+                return false;
+            }
+            bool selfClosing = false;
+            if (!tagEnd(selfClosing)) {
+                return false;
+            }
+            if (!selfClosing) {
+                m_foreign.push_back(name);
+            }
+        } else if ((c == '!') && (m_pos + 3 < m_size) && (m_html[m_pos + 2] == '-') && (m_html[m_pos + 3] == '-')) {
+            if (!skipComment()) {
+                return false;
+            }
+        } else if ((c == '!') || (c == '?')) { // CDATA sections are not expected
+            return false;
+        } else {
+            ++m_pos;
+        }
+    }
+
+    return true;
+}
+
+bool htmlScanner_t::skipComment() {
+    auto pos = m_pos + 4;
+    // abrupt closing of empty comments
+    if ((pos < m_size) && (m_html[pos] == '>')) {
+        m_pos = pos + 1;
+        return true;
+    }
+    if ((pos + 1 < m_size) && (m_html[pos] == '-') && (m_html[pos + 1] == '>')) {
+        m_pos = pos + 2;
+        return true;
+    }
+
+    // "-->" or "--!>"
+    while (pos + 2 < m_size) {
+        auto end = static_cast<const char *>(std::memchr(m_html + pos, '-', m_size - pos - 2));
+        if (end == nullptr) {
+            break;
+        }
+        pos = static_cast<std::size_t>(end - m_html);
+        if (m_html[pos + 1] == '-') {
+            if (m_html[pos + 2] == '>') {
+                m_pos = pos + 3;
+                return true;
+            }
+            if ((m_html[pos + 2] == '!') && (pos + 3 < m_size) && (m_html[pos + 3] == '>')) {
+                m_pos = pos + 4;
+                return true;
+            }
+        }
+        ++pos;
+    }
+
+    return false;
+}
+
+bool htmlScanner_t::skipUntil(char _c) {
+    auto end = static_cast<const char *>(std::memchr(m_html + m_pos, _c, m_size - m_pos));
+    if (end == nullptr) {
+        return false;
+    }
+    m_pos = static_cast<std::size_t>(end - m_html) + 1;
+
+    return true;
+}
+
+void htmlScanner_t::close(const element_t &_element, document_t &_data, std::string &_text) {
+    if (_element.text) {
+        --m_collectors;
+        if (_element.slot < 0) {
+            // nested elements follow the outermost one in document order
+            for (const auto &slot:m_slots) {
+                if (!slot.empty()) {
+                    append(slot, _text);
+                }
+            }
+            m_slots.clear();
+            m_openSlots.clear();
+        } else {
+            m_openSlots.pop_back();
+        }
+    }
+    if (_element.title) {
+        m_titleCollector = false;
+    }
+    if (_element.time) {
+        m_timeCollector = false;
+        textExtractor_t::str2time(m_timeText, _data.time);
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file dataLoader/htmlScanner.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_HTMLSCANNER_H
+#define TGNEWS_HTMLSCANNER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.h"
+
+// Single pass HTML scanner, extracts the same document_t fields as Gumbo tree traversal does, but keeps
+// only the stack of open elements. Markup that makes HTML5 tree construction diverge from the source nesting
+// (implied end tags, misnested or table elements, foreign content, unknown character references, etc.)
+// is not supported, the scanner gives up and the document must be parsed by Gumbo.
+class htmlScanner_t final {
+public:
+    htmlScanner_t() = default;
+
+    // returns false if the document must be parsed by Gumbo, _data and _text are in undefined state then
+    bool operator()(const char *_html, std::size_t _size, document_t &_data, std::string &_text);
+
+private:
+    enum class tag_t : uint8_t {
+        OTHER,
+        P,
+        LI,
+        H1,
+        HN,
+        TIME,
+        META,
+        PRE,
+        LIST,
+        DL,
+        DD,
+        A,
+        NOBR,
+        BUTTON,
+        FORM,
+        OPTION,
+        NOSCRIPT,
+        SCRIPT,
+        RAWTEXT,
+        XMP,
+        RCDATA,
+        VOID,
+        HR,
+        BLOCK,
+        STRUCTURE,
+        FOREIGN,
+        UNSUPPORTED
+    };
+
+    struct element_t {
+        std::string_view name;
+        tag_t tag = tag_t::OTHER;
+        bool title = false;
+        bool time = false;
+        bool text = false;
+        // text collector slot, -1 - the outermost collector writes directly to the output
+        int slot = -1;
+    };
+
+    const char *m_html = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_pos = 0;
+
+    std::vector<element_t> m_stack;
+    std::vector<std::string_view> m_foreign;
+    std::string m_pending;
+    std::string m_timeText;
+    std::vector<std::string> m_slots;
+    std::vector<int> m_openSlots;
+    std::size_t m_collectors = 0;
+    bool m_titleCollector = false;
+    bool m_timeCollector = false;
+    bool m_skipNewLine = false;
+
+    static tag_t tag(std::string_view _name) noexcept;
+    static bool equal(std::string_view _l, std::string_view _r) noexcept;
+    static std::string_view lower(std::string_view _name, char *_buffer, std::size_t _size) noexcept;
+    static bool validUtf8(std::string_view _str) noexcept;
+    static void appendUtf8(uint32_t _codePoint, std::string &_str);
+    static void append(const std::string &_src, std::string &_dst);
+
+    [[nodiscard]] bool collecting() const noexcept {return (m_collectors > 0) || m_titleCollector || m_timeCollector;}
+    [[nodiscard]] bool opened(tag_t _tag) const noexcept;
+
+    bool text();
+    bool charRef();
+    bool flush(document_t &_data, std::string &_text);
+    bool tagEnd(bool &_selfClosing);
+    bool startTag(document_t &_data, std::string &_text);
+    bool endTag(document_t &_data, std::string &_text);
+    bool skipRawText(std::string_view _name);
+    bool skipForeign(std::string_view _name);
+    bool skipComment();
+    bool skipUntil(char _c);
+    void close(const element_t &_element, document_t &_data, std::string &_text);
+};
+
+#endif //TGNEWS_HTMLSCANNER_H
@@ -0,0 +1,75 @@
+/**
+ * @file dataLoader/loaderScalingBench.cpp
+ * @brief load phase scaling: documents loaded, parsed and collected by dataLoader_t with 1 to 32 threads
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dataLoader.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " html_dir [threads ...] [-r repeats] [-p gumbo|scanner]" << std::endl
+                  << "  threads - 1 2 4 8 16 32 by default" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<unsigned int> threads;
+    int repeats = 3;
+    auto parser = htmlParser_t::GUMBO;
+    for (int i = 2; i < argc; ++i) {
+        if ((std::string(argv[i]) == "-r") && (i + 1 < argc)) {
+            repeats = std::max(1, std::atoi(argv[++i]));
+        } else if ((std::string(argv[i]) == "-p") && (i + 1 < argc)) {
+            parser = (std::string(argv[++i]) == "scanner")?htmlParser_t::SCANNER:htmlParser_t::GUMBO;
+        } else {
+            threads.emplace_back(std::clamp(static_cast<unsigned int>(std::stoul(argv[i])), 1u, 255u));
+        }
+    }
+    if (threads.empty()) {
+        threads = {1, 2, 4, 8, 16, 32};
+    }
+
+    char *paths[] = {argv[1], nullptr};
+    // page cache is populated, so the runs measure parsing and result collection, not the storage
+    {
+        dataLoader_t dataLoader(1, {}, paths, true, parser);
+    }
+
+    std::cout << std::thread::hardware_concurrency() << " cores, best of " << repeats << std::endl
+              << std::setw(8) << "threads" << std::setw(12) << "ms" << std::setw(10) << "docs"
+              << std::setw(12) << "docs/s" << std::setw(10) << "speedup" << std::endl
+              << std::fixed;
+    double baseline = 0.0;
+    for (auto t:threads) {
+        double ms = 0.0;
+        std::size_t docs = 0;
+        for (int i = 0; i < repeats; ++i) {
+            auto started = std::chrono::steady_clock::now();
+            dataLoader_t dataLoader(static_cast<uint8_t>(t), {}, paths, true, parser);
+            auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+                                                                     - started).count();
+            ms = (i == 0)?elapsed:std::min(ms, elapsed);
+            docs = 0;
+            for (const auto &l:dataLoader.langDocSet()) {
+                docs += l.second.size();
+            }
+        }
+        if (baseline == 0.0) {
+            baseline = ms;
+        }
+        std::cout << std::setw(8) << t << std::setw(12) << std::setprecision(0) << ms << std::setw(10) << docs
+                  << std::setw(12) << static_cast<double>(docs) * 1000.0 / ms
+                  << std::setw(10) << std::setprecision(2) << baseline / ms << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file dataLoader/mappedFile.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "mappedFile.h"
+
+mappedFile_t::~mappedFile_t() {
+    close();
+}
+
+bool mappedFile_t::open(const std::string &_fileName, std::size_t &_syscalls) noexcept {
+    close();
+    _syscalls = 0;
+
+    auto fd = ::open(_fileName.c_str(), O_RDONLY);
+    ++_syscalls;
+    if (fd < 0) {
+        std::cerr << _fileName << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    bool ret = false;
+    struct stat st {};
+    ++_syscalls;
+    if (fstat(fd, &st) != 0) {
+        std::cerr << _fileName << ": " << std::strerror(errno) << std::endl;
+    } else if (st.st_size == 0) {
+        m_data = m_buffer.data();
+        ret = true;
+    } else if (static_cast<std::size_t>(st.st_size) >= minMapSize) {
+        ++_syscalls;
+        auto addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            std::cerr << _fileName << ": " << std::strerror(errno) << std::endl;
+        } else {
+            // the whole file is parsed from the beginning to the end just once, advice values are not flags,
+            // so they are given one by one
+            _syscalls += 2;
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            madvise(addr, st.st_size, MADV_WILLNEED);
+            m_data = static_cast<const uint8_t *>(addr);
+            m_size = st.st_size;
+            m_mapped = true;
+            ++_syscalls; // munmap() on close
+            ret = true;
+        }
+    } else {
+        m_buffer.resize(st.st_size);
+        std::size_t done = 0;
+        while (done < m_buffer.size()) {
+            ++_syscalls;
+            auto r = read(fd, m_buffer.data() + done, m_buffer.size() - done);
+            if (r < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << _fileName << ": " << std::strerror(errno) << std::endl;
+                break;
+            }
+            if (r == 0) { // file was truncated
+                break;
+            }
+            done += r;
+        }
+        if (done > 0) {
+            m_data = m_buffer.data();
+            m_size = done;
+            ret = true;
+        }
+    }
+
+    ::close(fd);
+    ++_syscalls;
+
+    return ret;
+}
+
+void mappedFile_t::close() noexcept {
+    if (m_mapped) {
+        munmap(const_cast<uint8_t *>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file dataLoader/mappedFile.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_MAPPEDFILE_H
+#define TGNEWS_MAPPEDFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// read-only view of a file content: large files are memory mapped, small ones are read into a reusable buffer
+class mappedFile_t final {
+public:
+    // files smaller than this value are read, mmap/munmap overhead is higher than copying for them
+    static const std::size_t minMapSize = 16 * 1024;
+
+    mappedFile_t() = default;
+    ~mappedFile_t();
+
+    mappedFile_t(const mappedFile_t &) = delete;
+    void operator=(const mappedFile_t &) = delete;
+
+    // opens the file, previously opened one is closed; returns number of issued syscalls via _syscalls
+    bool open(const std::string &_fileName, std::size_t &_syscalls) noexcept;
+    void close() noexcept;
+
+    [[nodiscard]] const uint8_t *data() const noexcept {return m_data;}
+    [[nodiscard]] std::size_t size() const noexcept {return m_size;}
+    [[nodiscard]] bool mapped() const noexcept {return m_mapped;}
+
+private:
+    const uint8_t *m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<uint8_t> m_buffer;
+};
+
+#endif //TGNEWS_MAPPEDFILE_H
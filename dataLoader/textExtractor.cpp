@@ -5,39 +5,102 @@
  * @date 02.12.2019
 */
 
-#include <regex>
+#include <ctime>
+#include <string_view>
 #include <iostream>
 
+#include "gumboArena.h"
 #include "textExtractor.h"
 
-bool textExtractor_t::operator()(const std::vector<uint8_t> &_html, document_t &_data) noexcept {
-    auto tree = gumbo_parse_with_options(&kGumboDefaultOptions,
-                                         reinterpret_cast<const char *>(_html.data()),
-                                         _html.size());
-    bool ret = true;
+bool textExtractor_t::operator()(const uint8_t *_html, std::size_t _size, document_t &_data) noexcept {
     try {
-        parse(tree->root, _data);
+        thread_local std::string text;
+        text.clear();
+        if (text.capacity() > maxTextBufferCapacity) {
+            text.shrink_to_fit();
+        }
+        text.reserve(textBufferCapacity);
+
+        auto html = reinterpret_cast<const char *>(_html);
+        switch (m_htmlParser) {
+            case htmlParser_t::SCANNER: {
+                document_t data(_data);
+                if (m_htmlScanner(html, _size, data, text)) {
+                    _data = std::move(data);
+                } else {
+                    text.clear();
+                    parseTree(html, _size, _data, text);
+                }
+                break;
+            }
+            case htmlParser_t::VERIFY: {
+                document_t data(_data);
+                std::string scannedText;
+                bool scanned = m_htmlScanner(html, _size, data, scannedText);
+                parseTree(html, _size, _data, text);
+                if (scanned) {
+                    finalize(data, scannedText);
+                    finalize(_data, text);
+                    if ((data.site != _data.site) || (data.title != _data.title)
+                        || (data.time != _data.time) || (data.text != _data.text)) {
+                        std::cerr << "HTML scanner mismatch: " << _data.name << std::endl;
+                    }
+                    return true;
+                }
+                break;
+            }
+            default:
+                parseTree(html, _size, _data, text);
+                break;
+        }
+        finalize(_data, text);
     } catch (const std::exception &_e) {
         std::cerr << _e.what() << std::endl;
-        ret = false;
+        return false;
     } catch (...) {
         std::cerr << "unknown error" << std::endl;
-        ret = false;
+        return false;
     }
 
-    gumbo_destroy_output(&kGumboDefaultOptions, tree);
+    return true;
+}
+
+void textExtractor_t::parseTree(const char *_html, std::size_t _size, document_t &_data, std::string &_text) const {
+    // the tree is allocated from the thread arena and dropped at once, without walking it
+    thread_local gumboArena_t arena;
+    auto tree = gumbo_parse_with_options(arena.options(), _html, _size);
+    try {
+        parse(tree->root, _data, _text);
+    } catch (...) {
+        arena.reset();
+        throw;
+    }
+    arena.reset();
+}
 
-    return ret;
+void textExtractor_t::finalize(document_t &_data, std::string &_text) const {
+    if (m_maxTextLength > 0) {
+        truncate(_text, m_maxTextLength);
+    }
+    if (!_text.empty()) {
+        if (!_data.text.empty()) {
+            _data.text += ' ';
+        }
+        _data.text += _text;
+    }
+    if (m_maxTitleLength > 0) {
+        truncate(_data.title, m_maxTitleLength);
+    }
 }
 
-void textExtractor_t::parse(const GumboNode *_node, document_t &_data) {
+void textExtractor_t::parse(const GumboNode *_node, document_t &_data, std::string &_text) const {
     if (_node->type != GUMBO_NODE_ELEMENT) {
         return;
     }
 
     if (_node->v.element.tag == GUMBO_TAG_H1) {
         if (_data.title.empty()) {
-            getText(_node, _data.title);
+            getText(_node, _data.title, m_maxTitleLength);
         }
     } else if (_node->v.element.tag == GUMBO_TAG_TIME) {
         if (_data.time == 0) {
@@ -46,7 +109,7 @@ void textExtractor_t::parse(const GumboNode *_node, document_t &_data) {
             str2time(tmp, _data.time);
         }
     } else if ((_node->v.element.tag == GUMBO_TAG_P) || (_node->v.element.tag == GUMBO_TAG_LI)) {
-        getText(_node, _data.text);
+        getText(_node, _text, m_maxTextLength);
     } else if (_node->v.element.tag == GUMBO_TAG_META) {
         std::string key;
         std::string value;
@@ -64,59 +127,122 @@ void textExtractor_t::parse(const GumboNode *_node, document_t &_data) {
 
     auto children = &_node->v.element.children;
     for (unsigned int i = 0; i < children->length; ++i) {
-        parse(static_cast<GumboNode *>(children->data[i]), _data);
+        parse(static_cast<GumboNode *>(children->data[i]), _data, _text);
     }
 }
 
-void textExtractor_t::getText(const GumboNode *_node, std::string &_text) {
+void textExtractor_t::getText(const GumboNode *_node, std::string &_text, std::size_t _maxLength) {
+    // stop collecting when the limit is reached, the text is truncated by finalize()
+    if ((_maxLength > 0) && (_text.length() >= _maxLength)) {
+        return;
+    }
+
     if (_node->type == GUMBO_NODE_TEXT) {
-        _text = _text + (_text.empty()?"":" ") +  _node->v.text.text;
+        if (!_text.empty()) {
+            _text += ' ';
+        }
+        _text += _node->v.text.text;
     } else if (_node->type == GUMBO_NODE_ELEMENT &&
                _node->v.element.tag != GUMBO_TAG_SCRIPT &&
                _node->v.element.tag != GUMBO_TAG_STYLE) {
         auto children = &_node->v.element.children;
         for (unsigned int i = 0; i < children->length; ++i) {
-            getText(static_cast<GumboNode *>(children->data[i]), _text);
+            getText(static_cast<GumboNode *>(children->data[i]), _text, _maxLength);
         }
     }
 }
 
-bool textExtractor_t::getMeta(const GumboNode *_node, std::string &_key, std::string &_value) {
-    if (_node->v.element.original_tag.length > 0) {
-        std::string tag(_node->v.element.original_tag.data, _node->v.element.original_tag.length);
+void textExtractor_t::truncate(std::string &_text, std::size_t _maxLength) noexcept {
+    if (_text.length() <= _maxLength) {
+        return;
+    }
+    // step back to the first byte of a UTF-8 sequence
+    auto pos = _maxLength;
+    while ((pos > 0) && ((static_cast<uint8_t>(_text[pos]) & 0xc0) == 0x80)) {
+        --pos;
+    }
+    _text.resize(pos);
+}
+
+bool textExtractor_t::getMeta(std::string_view _tag, std::string &_key, std::string &_value) {
+    // <meta property="key" content="value"/>
+    static const std::string_view prefix = R"(<meta property=")";
+    static const std::string_view separator = R"(" content=")";
+    static const std::string_view suffix = R"("/>)";
+
+    if ((_tag.length() < prefix.length() + separator.length() + suffix.length() + 2)
+        || (_tag.compare(0, prefix.length(), prefix) != 0)
+        || (_tag.compare(_tag.length() - suffix.length(), suffix.length(), suffix) != 0)) {
+        return false;
+    }
 
-        std::regex rgx("^<meta property=\"(.+)\" content=\"(.+)\"/>$");
-        std::smatch match;
-        if (std::regex_search(tag, match, rgx) && (match.size() == 3)) {
-            _key = match[1];
-            _value = match[2];
+    auto attrs = _tag.substr(prefix.length(), _tag.length() - prefix.length() - suffix.length());
+    if (attrs.find_first_of("\r\n") != std::string_view::npos) {
+        return false;
+    }
+    // the last separator followed by non-empty value
+    auto pos = attrs.rfind(separator, attrs.length() - separator.length() - 1);
+    if ((pos == std::string_view::npos) || (pos == 0)) {
+        return false;
+    }
+
+    _key.assign(attrs.substr(0, pos));
+    _value.assign(attrs.substr(pos + separator.length()));
+
+    return true;
+}
 
-            return true;
+bool textExtractor_t::str2int(const std::string &_str, std::size_t &_pos, int &_value) {
+    auto startFrom = _pos;
+    _value = 0;
+    while ((_pos < _str.length()) && (_str[_pos] >= '0') && (_str[_pos] <= '9')) {
+        if (_pos - startFrom >= 9) { // int overflow
+            return false;
         }
+        _value = _value * 10 + (_str[_pos] - '0');
+        ++_pos;
     }
 
-    return false;
+    return (_pos > startFrom);
 }
 
 bool textExtractor_t::str2time(const std::string &_str, uint64_t &_t) {
-    std::regex rgx(R"(^(\d+)-(\d+)-(\d+)T(\d+):(\d+):(\d+)(.)(\d+):(\d+)$)");
-    std::smatch match;
-    if (std::regex_search(_str, match, rgx) && (match.size() == 10)) {
-        std::tm tm {};
-        tm.tm_year = std::stoi(match[1]) - 1900;
-        tm.tm_mon = std::stoi(match[2]) - 1;
-        tm.tm_mday = std::stoi(match[3]);
-        tm.tm_hour = std::stoi(match[4]);
-        tm.tm_min = std::stoi(match[5]);
-        tm.tm_sec = std::stoi(match[6]);
-        auto c = match[7];
-        auto off = (std::stoi(match[8]) * 60 + std::stoi(match[9])) * 60;
-        tm.tm_gmtoff = (c == "+")?off:-off;
-
-        _t = std::mktime(&tm);
-
-        return true;
-    }
-
-    return false;
+    // YYYY-MM-DDThh:mm:ss+hh:mm
+    int values[8] = {0};
+    const char delimiters[8] = {'-', '-', 'T', ':', ':', 0, ':', 0};
+    char sign = 0;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        if (!str2int(_str, pos, values[i])) {
+            return false;
+        }
+        if (i == 5) { // any timezone sign char
+            if ((pos >= _str.length()) || (_str[pos] == '\n') || (_str[pos] == '\r')) {
+                return false;
+            }
+            sign = _str[pos++];
+        } else if (delimiters[i] != 0) {
+            if ((pos >= _str.length()) || (_str[pos] != delimiters[i])) {
+                return false;
+            }
+            ++pos;
+        }
+    }
+    if (pos != _str.length()) {
+        return false;
+    }
+
+    std::tm tm {};
+    tm.tm_year = values[0] - 1900;
+    tm.tm_mon = values[1] - 1;
+    tm.tm_mday = values[2];
+    tm.tm_hour = values[3];
+    tm.tm_min = values[4];
+    tm.tm_sec = values[5];
+    auto off = (values[6] * 60 + values[7]) * 60;
+    tm.tm_gmtoff = (sign == '+')?off:-off;
+
+    _t = std::mktime(&tm);
+
+    return true;
 }
@@ -8,19 +8,52 @@
 #ifndef TGNEWS_TEXTEXTRACTOR_H
 #define TGNEWS_TEXTEXTRACTOR_H
 
+#include <string_view>
 #include <gumbo.h>
 
 #include "types.h"
+#include "htmlScanner.h"
 
 class textExtractor_t final {
+    friend class htmlScanner_t;
+
 public:
-    bool operator()(const std::vector<uint8_t> &_html, document_t &_data) noexcept;
+    // max title/text length in bytes, 0 - unlimited; truncated strings keep UTF-8 sequences whole
+    explicit textExtractor_t(htmlParser_t _htmlParser = htmlParser_t::GUMBO,
+                             std::size_t _maxTitleLength = 0,
+                             std::size_t _maxTextLength = 0) noexcept:
+            m_htmlParser(_htmlParser), m_maxTitleLength(_maxTitleLength), m_maxTextLength(_maxTextLength) {}
 
-private:
-    static void parse(const GumboNode *_node, document_t &_data);
-    static void getText(const GumboNode *_node, std::string &_text);
-    static bool getMeta(const GumboNode *_node, std::string &_key,std::string &_value);
+    bool operator()(const std::vector<uint8_t> &_html, document_t &_data) noexcept {
+        return operator()(_html.data(), _html.size(), _data);
+    }
+    bool operator()(const uint8_t *_html, std::size_t _size, document_t &_data) noexcept;
+
+    // <meta property="key" content="value"/>
+    static bool getMeta(std::string_view _tag, std::string &_key, std::string &_value);
+    // YYYY-MM-DDThh:mm:ss+hh:mm
     static bool str2time(const std::string &_str, uint64_t &_t);
+
+private:
+    // text buffer is reused between documents parsed by the same thread
+    static const std::size_t textBufferCapacity = 64 * 1024;
+    static const std::size_t maxTextBufferCapacity = 4 * 1024 * 1024;
+
+    const htmlParser_t m_htmlParser;
+    const std::size_t m_maxTitleLength;
+    const std::size_t m_maxTextLength;
+    htmlScanner_t m_htmlScanner;
+
+    void parseTree(const char *_html, std::size_t _size, document_t &_data, std::string &_text) const;
+    void finalize(document_t &_data, std::string &_text) const;
+    void parse(const GumboNode *_node, document_t &_data, std::string &_text) const;
+    static void getText(const GumboNode *_node, std::string &_text, std::size_t _maxLength = 0);
+    static void truncate(std::string &_text, std::size_t _maxLength) noexcept;
+    static bool getMeta(const GumboNode *_node, std::string &_key, std::string &_value) {
+        return getMeta(std::string_view(_node->v.element.original_tag.data, _node->v.element.original_tag.length),
+                       _key, _value);
+    }
+    static bool str2int(const std::string &_str, std::size_t &_pos, int &_value);
 };
 
 #endif //TGNEWS_TEXTEXTRACTOR_H
@@ -0,0 +1,257 @@
+/**
+ * @file dataLoader/textExtractorBench.cpp
+ * @brief HTML parsing throughput, the former std::regex path against the scanners
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <regex>
+#include <vector>
+
+#include "fileEnumerator.h"
+#include "textExtractor.h"
+
+// meta and timestamp parsing as it was done before the scanners, a regex is built per call
+static bool regexMeta(const std::string &_tag, std::string &_key, std::string &_value) {
+    std::regex rgx("^<meta property=\"(.+)\" content=\"(.+)\"/>$");
+    std::smatch match;
+    if (std::regex_search(_tag, match, rgx) && (match.size() == 3)) {
+        _key = match[1];
+        _value = match[2];
+        return true;
+    }
+
+    return false;
+}
+
+static bool regexTime(const std::string &_str, uint64_t &_t) {
+    std::regex rgx(R"(^(\d+)-(\d+)-(\d+)T(\d+):(\d+):(\d+)(.)(\d+):(\d+)$)");
+    std::smatch match;
+    if (std::regex_search(_str, match, rgx) && (match.size() == 10)) {
+        std::tm tm {};
+        tm.tm_year = std::stoi(match[1]) - 1900;
+        tm.tm_mon = std::stoi(match[2]) - 1;
+        tm.tm_mday = std::stoi(match[3]);
+        tm.tm_hour = std::stoi(match[4]);
+        tm.tm_min = std::stoi(match[5]);
+        tm.tm_sec = std::stoi(match[6]);
+        auto off = (std::stoi(match[8]) * 60 + std::stoi(match[9])) * 60;
+        tm.tm_gmtoff = (match[7] == "+")?off:-off;
+        _t = std::mktime(&tm);
+        return true;
+    }
+
+    return false;
+}
+
+// the former tree walk: default Gumbo allocator, regex meta and timestamp parsing
+static void regexParse(const GumboNode *_node, document_t &_data);
+
+static void regexText(const GumboNode *_node, std::string &_text) {
+    if (_node->type == GUMBO_NODE_TEXT) {
+        _text = _text + (_text.empty()?"":" ") + _node->v.text.text;
+    } else if ((_node->type == GUMBO_NODE_ELEMENT) && (_node->v.element.tag != GUMBO_TAG_SCRIPT)
+               && (_node->v.element.tag != GUMBO_TAG_STYLE)) {
+        auto children = &_node->v.element.children;
+        for (unsigned int i = 0; i < children->length; ++i) {
+            regexText(static_cast<GumboNode *>(children->data[i]), _text);
+        }
+    }
+}
+
+static void regexParse(const GumboNode *_node, document_t &_data) {
+    if (_node->type != GUMBO_NODE_ELEMENT) {
+        return;
+    }
+
+    if (_node->v.element.tag == GUMBO_TAG_H1) {
+        if (_data.title.empty()) {
+            regexText(_node, _data.title);
+        }
+    } else if (_node->v.element.tag == GUMBO_TAG_TIME) {
+        if (_data.time == 0) {
+            std::string tmp;
+            regexText(_node, tmp);
+            regexTime(tmp, _data.time);
+        }
+    } else if ((_node->v.element.tag == GUMBO_TAG_P) || (_node->v.element.tag == GUMBO_TAG_LI)) {
+        regexText(_node, _data.text);
+    } else if ((_node->v.element.tag == GUMBO_TAG_META) && (_node->v.element.original_tag.length > 0)) {
+        std::string key;
+        std::string value;
+        if (regexMeta(std::string(_node->v.element.original_tag.data, _node->v.element.original_tag.length),
+                      key, value)) {
+            if (key == "og:site_name") {
+                _data.site = std::move(value);
+            } else if (key == "article:published_time") {
+                regexTime(value, _data.time);
+            } else if (key == "og:title") {
+                _data.title = std::move(value);
+            }
+        }
+    }
+
+    auto children = &_node->v.element.children;
+    for (unsigned int i = 0; i < children->length; ++i) {
+        regexParse(static_cast<GumboNode *>(children->data[i]), _data);
+    }
+}
+
+static bool regexExtract(const std::vector<uint8_t> &_html, document_t &_data) {
+    auto tree = gumbo_parse_with_options(&kGumboDefaultOptions, reinterpret_cast<const char *>(_html.data()),
+                                         _html.size());
+    bool ret = true;
+    try {
+        regexParse(tree->root, _data);
+    } catch (...) {
+        ret = false;
+    }
+    gumbo_destroy_output(&kGumboDefaultOptions, tree);
+
+    return ret;
+}
+
+// <meta> tags and <time> texts of a document, found by a plain search
+struct metaSet_t {
+    std::vector<std::string> tags;
+    std::vector<std::string> times;
+};
+
+static metaSet_t findMeta(const std::vector<uint8_t> &_html) {
+    metaSet_t ret;
+    std::string_view html(reinterpret_cast<const char *>(_html.data()), _html.size());
+    for (auto pos = html.find("<meta "); pos != std::string_view::npos; pos = html.find("<meta ", pos + 1)) {
+        auto end = html.find('>', pos);
+        if (end == std::string_view::npos) {
+            break;
+        }
+        ret.tags.emplace_back(html.substr(pos, end + 1 - pos));
+    }
+    for (auto pos = html.find("<time"); pos != std::string_view::npos; pos = html.find("<time", pos + 1)) {
+        auto start = html.find('>', pos);
+        auto end = html.find("</time>", pos);
+        if ((start == std::string_view::npos) || (end == std::string_view::npos) || (start > end)) {
+            break;
+        }
+        ret.times.emplace_back(html.substr(start + 1, end - start - 1));
+    }
+
+    return ret;
+}
+
+// runs _pass over all documents until _seconds elapsed, returns docs/s
+template<typename pass_t>
+static double measure(const pass_t &_pass, std::size_t _docs, double _seconds) {
+    std::size_t docs = 0;
+    auto started = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < _seconds) {
+        _pass();
+        docs += _docs;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    return static_cast<double>(docs) / elapsed;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " html_dir_or_file ..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::vector<uint8_t>> bodies;
+    {
+        std::mutex mtx;
+        fileEnumerator_t enumerator(4, 256);
+        enumerator(argv + 1, [&](fileEnumerator_t::fileBatch_t &&_batch) {
+            for (const auto &i:_batch) {
+                std::ifstream ifs(i.first + i.second, std::ios::binary);
+                std::vector<uint8_t> body((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+                std::unique_lock<std::mutex> lck(mtx);
+                bodies.emplace_back(std::move(body));
+            }
+        });
+    }
+    if (bodies.empty()) {
+        std::cerr << "no documents found" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::vector<metaSet_t> metaSets;
+    for (const auto &i:bodies) {
+        metaSets.emplace_back(findMeta(i));
+    }
+
+    volatile std::size_t sink = 0;
+    std::cout << bodies.size() << " documents" << std::endl << std::fixed << std::setprecision(0);
+
+    // meta and timestamp parsing alone, the part replaced by the scanners
+    uint64_t t = 0;
+    std::string key;
+    std::string value;
+    auto metaRegex = measure([&] {
+        for (const auto &m:metaSets) {
+            for (const auto &i:m.tags) {
+                sink = sink + (regexMeta(i, key, value)?1:0);
+            }
+            for (const auto &i:m.times) {
+                sink = sink + (regexTime(i, t)?1:0);
+            }
+        }
+    }, bodies.size(), 2.0);
+    auto metaScanner = measure([&] {
+        for (const auto &m:metaSets) {
+            for (const auto &i:m.tags) {
+                sink = sink + (textExtractor_t::getMeta(i, key, value)?1:0);
+            }
+            for (const auto &i:m.times) {
+                sink = sink + (textExtractor_t::str2time(i, t)?1:0);
+            }
+        }
+    }, bodies.size(), 2.0);
+    std::cout << "meta and time, regex   " << std::setw(12) << metaRegex << " docs/s" << std::endl
+              << "meta and time, scanner " << std::setw(12) << metaScanner << " docs/s" << std::endl;
+
+    // whole documents
+    auto regexRate = measure([&] {
+        for (const auto &i:bodies) {
+            document_t doc;
+            regexExtract(i, doc);
+            sink = sink + doc.text.size();
+        }
+    }, bodies.size(), 2.0);
+    std::cout << "document, regex        " << std::setw(12) << regexRate << " docs/s" << std::endl;
+    for (auto parser:{htmlParser_t::GUMBO, htmlParser_t::SCANNER}) {
+        textExtractor_t textExtractor(parser);
+        std::size_t mismatches = 0;
+        for (const auto &i:bodies) {
+            document_t before;
+            document_t after;
+            regexExtract(i, before);
+            textExtractor(i, after);
+            if ((before.site != after.site) || (before.title != after.title) || (before.time != after.time)) {
+                ++mismatches;
+            }
+        }
+        auto rate = measure([&] {
+            for (const auto &i:bodies) {
+                document_t doc;
+                textExtractor(i, doc);
+                sink = sink + doc.text.size();
+            }
+        }, bodies.size(), 2.0);
+        std::cout << "document, " << ((parser == htmlParser_t::GUMBO)?"gumbo  ":"scanner") << "      "
+                  << std::setw(12) << rate << " docs/s, " << mismatches << " site, title or time mismatches"
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,400 @@
+/**
+ * @file dataLoader/uringReader.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define TGNEWS_IO_URING
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+
+#include "uringReader.h"
+
+struct uringReader_t::slot_t {
+    // operation is stored in the lower bits of the request user data, slot index - in the upper ones
+    enum op_t: uint64_t {OPEN = 0, STAT = 1, READ = 2, CLOSE = 3};
+    static const uint64_t opBits = 2;
+
+    std::size_t idx = 0;
+    std::string name;
+    int fd = -1;
+    int error = 0;
+    // requests in flight
+    unsigned pending = 0;
+#ifdef TGNEWS_IO_URING
+    struct statx stx {};
+#endif
+    // not initialized, the kernel overwrites it
+    std::unique_ptr<uint8_t[]> buffer;
+    std::size_t capacity = 0;
+    std::size_t size = 0;
+    std::size_t done = 0;
+
+    void resize(std::size_t _size) {
+        if (_size > capacity) {
+            buffer.reset(new uint8_t[_size]);
+            capacity = _size;
+        }
+        size = _size;
+    }
+};
+
+uringReader_t::uringReader_t() noexcept {
+    if (!setup()) {
+        release();
+    }
+}
+
+uringReader_t::~uringReader_t() {
+    release();
+}
+
+#ifdef TGNEWS_IO_URING
+
+bool uringReader_t::setup() noexcept {
+    io_uring_params params {};
+    m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, 4 * queueDepth, &params));
+    if (m_fd < 0) { // not supported or disabled by the system policy
+        return false;
+    }
+
+    // open, statx, read and close requests are available since Linux 5.6
+    alignas(io_uring_probe) uint8_t probeBuffer[sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)] {};
+    auto probe = reinterpret_cast<io_uring_probe *>(probeBuffer);
+    if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+        return false;
+    }
+    for (auto op:{IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE}) {
+        if ((op > probe->last_op) || ((probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)) {
+            return false;
+        }
+    }
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        m_sqRingSize = (m_sqRingSize > m_cqRingSize)?m_sqRingSize:m_cqRingSize;
+        m_cqRingSize = 0;
+    }
+
+    auto addr = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                     IORING_OFF_SQ_RING);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    m_sqRing = addr;
+    if (singleMmap) {
+        m_cqRing = m_sqRing;
+    } else {
+        addr = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                    IORING_OFF_CQ_RING);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        m_cqRing = addr;
+    }
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    addr = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    m_sqes = addr;
+
+    auto sq = static_cast<uint8_t *>(m_sqRing);
+    m_sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto cq = static_cast<uint8_t *>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    m_cqes = cq + params.cq_off.cqes;
+
+    return true;
+}
+
+void uringReader_t::release() noexcept {
+    if (m_sqes != nullptr) {
+        munmap(m_sqes, m_sqesSize);
+    }
+    if ((m_cqRing != nullptr) && (m_cqRing != m_sqRing)) {
+        munmap(m_cqRing, m_cqRingSize);
+    }
+    if (m_sqRing != nullptr) {
+        munmap(m_sqRing, m_sqRingSize);
+    }
+    m_sqes = m_cqRing = m_sqRing = nullptr;
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+io_uring_sqe *uringReader_t::sqe() noexcept {
+    // a slot prepares at most three requests (close, open and statx) between submissions, the queue is four times
+    // larger than the number of slots and never full here
+    auto tail = *m_sqTail;
+    auto idx = tail & m_sqMask;
+    auto ret = static_cast<io_uring_sqe *>(m_sqes) + idx;
+    std::memset(ret, 0, sizeof(io_uring_sqe));
+    m_sqArray[idx] = idx;
+    __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++m_toSubmit;
+
+    return ret;
+}
+
+void uringReader_t::submit(std::size_t &_syscalls, bool _wait) {
+    while (true) {
+        ++_syscalls;
+        auto ret = ::syscall(__NR_io_uring_enter, m_fd, m_toSubmit, _wait?1:0, _wait?IORING_ENTER_GETEVENTS:0,
+                             nullptr, 0);
+        if (ret < 0) {
+            if ((errno == EINTR) || (errno == EAGAIN)) {
+                continue;
+            }
+            throw std::runtime_error(std::string("io_uring_enter: ") + std::strerror(errno));
+        }
+        m_toSubmit -= static_cast<unsigned>(ret);
+        return;
+    }
+}
+
+void uringReader_t::start(slot_t &_slot) {
+    uint64_t userData = static_cast<uint64_t>(&_slot - m_slots.data()) << slot_t::opBits;
+    _slot.fd = -1;
+    _slot.error = 0;
+    _slot.done = 0;
+
+    auto open = sqe();
+    open->opcode = IORING_OP_OPENAT;
+    open->fd = AT_FDCWD;
+    open->addr = reinterpret_cast<uint64_t>(_slot.name.c_str());
+    open->open_flags = O_RDONLY | O_CLOEXEC;
+    open->user_data = userData | slot_t::OPEN;
+
+    // statx does not depend on open, both requests are executed concurrently
+    auto stat = sqe();
+    stat->opcode = IORING_OP_STATX;
+    stat->fd = AT_FDCWD;
+    stat->addr = reinterpret_cast<uint64_t>(_slot.name.c_str());
+    stat->len = STATX_SIZE;
+    stat->off = reinterpret_cast<uint64_t>(&_slot.stx);
+    stat->user_data = userData | slot_t::STAT;
+
+    _slot.pending = 2;
+}
+
+void uringReader_t::read(slot_t &_slot) {
+    // a single request reads up to 1GB
+    static const std::size_t maxReadSize = 1UL << 30;
+
+    auto size = _slot.size - _slot.done;
+    auto read = sqe();
+    read->opcode = IORING_OP_READ;
+    read->fd = _slot.fd;
+    read->addr = reinterpret_cast<uint64_t>(_slot.buffer.get() + _slot.done);
+    read->len = static_cast<uint32_t>((size > maxReadSize)?maxReadSize:size);
+    read->off = _slot.done;
+    read->user_data = (static_cast<uint64_t>(&_slot - m_slots.data()) << slot_t::opBits) | slot_t::READ;
+
+    _slot.pending = 1;
+}
+
+void uringReader_t::operator()(const fileEnumerator_t::fileBatch_t &_batch,
+                               const consumer_t &_consumer,
+                               std::size_t &_syscalls) {
+    _syscalls = 0;
+    if (m_slots.size() < queueDepth) {
+        m_slots.resize(queueDepth);
+    }
+
+    std::size_t next = 0;
+    std::size_t active = 0;
+    for (auto &s:m_slots) {
+        if (next == _batch.size()) {
+            break;
+        }
+        s.idx = next;
+        s.name = _batch[next].first + _batch[next].second;
+        start(s);
+        ++next;
+        ++active;
+    }
+
+    try {
+        while (active > 0) {
+            submit(_syscalls, true);
+
+            auto head = *m_cqHead;
+            auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                const auto &cqe = static_cast<const io_uring_cqe *>(m_cqes)[head & m_cqMask];
+                auto &slot = m_slots[cqe.user_data >> slot_t::opBits];
+                auto res = cqe.res;
+                auto op = cqe.user_data & ((1U << slot_t::opBits) - 1);
+                // consumer may take a while, completion entry is released before the file is parsed
+                __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+                if (op == slot_t::CLOSE) { // the slot is already reused
+                    continue;
+                }
+                --slot.pending;
+
+                if (op == slot_t::READ) {
+                    if ((res == -EINTR) || (res == -EAGAIN)) {
+                        read(slot);
+                        continue;
+                    }
+                    if (res < 0) {
+                        slot.error = -res;
+                    } else if (res == 0) { // file was truncated
+                        slot.size = slot.done;
+                        if (slot.done == 0) {
+                            slot.error = EIO;
+                        }
+                    } else {
+                        slot.done += static_cast<std::size_t>(res);
+                        if (slot.done < slot.size) {
+                            read(slot);
+                            continue;
+                        }
+                    }
+                } else {
+                    if (res < 0) {
+                        slot.error = -res;
+                    } else if (op == slot_t::OPEN) {
+                        slot.fd = res;
+                    }
+                    if (slot.pending > 0) {
+                        continue;
+                    }
+                    if ((slot.error == 0) && (slot.stx.stx_size > 0)) {
+                        slot.resize(slot.stx.stx_size);
+                        read(slot);
+                        continue;
+                    }
+                    slot.size = 0;
+                }
+
+                finish(slot, _consumer);
+                if (next < _batch.size()) {
+                    slot.idx = next;
+                    slot.name = _batch[next].first + _batch[next].second;
+                    start(slot);
+                    ++next;
+                } else {
+                    --active;
+                }
+            }
+        }
+        if (m_toSubmit > 0) { // close requests of the last files
+            submit(_syscalls, false);
+        }
+    } catch (...) {
+        // kernel still writes to the slots, wait for requests in flight before leaving
+        try {
+            for (auto &s:m_slots) {
+                while (s.pending > 0) {
+                    submit(_syscalls, true);
+                    auto head = *m_cqHead;
+                    auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+                    for (; head != tail; ++head) {
+                        const auto &cqe = static_cast<const io_uring_cqe *>(m_cqes)[head & m_cqMask];
+                        auto &slot = m_slots[cqe.user_data >> slot_t::opBits];
+                        auto op = cqe.user_data & ((1U << slot_t::opBits) - 1);
+                        if (op == slot_t::CLOSE) {
+                            continue;
+                        }
+                        if ((op == slot_t::OPEN) && (cqe.res >= 0)) {
+                            slot.fd = cqe.res;
+                        }
+                        --slot.pending;
+                    }
+                    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+                }
+            }
+            if (m_toSubmit > 0) {
+                submit(_syscalls, false);
+            }
+        } catch (...) {
+            // the ring is unusable, requests in flight are cancelled on close
+            release();
+        }
+        for (auto &s:m_slots) {
+            if (s.fd >= 0) {
+                ::close(s.fd);
+                s.fd = -1;
+            }
+            s.pending = 0;
+        }
+        throw;
+    }
+}
+
+void uringReader_t::finish(slot_t &_slot, const consumer_t &_consumer) {
+    // the result of close is not awaited, it is submitted with the next requests
+    if (_slot.fd >= 0) {
+        auto close = sqe();
+        close->opcode = IORING_OP_CLOSE;
+        close->fd = _slot.fd;
+        close->user_data = (static_cast<uint64_t>(&_slot - m_slots.data()) << slot_t::opBits) | slot_t::CLOSE;
+        _slot.fd = -1;
+    }
+
+    if (_slot.error != 0) {
+        std::cerr << _slot.name << ": " << std::strerror(_slot.error) << std::endl;
+    } else {
+        _consumer(_slot.idx, _slot.buffer.get(), _slot.size);
+    }
+
+    if (_slot.capacity > maxRetainedSize) {
+        _slot.buffer.reset();
+        _slot.capacity = 0;
+    }
+}
+
+#else
+
+bool uringReader_t::setup() noexcept {
+    return false;
+}
+
+void uringReader_t::release() noexcept {
+}
+
+io_uring_sqe *uringReader_t::sqe() noexcept {
+    return nullptr;
+}
+
+void uringReader_t::submit(std::size_t &, bool) {
+}
+
+void uringReader_t::start(slot_t &) {
+}
+
+void uringReader_t::read(slot_t &) {
+}
+
+void uringReader_t::finish(slot_t &, const consumer_t &) {
+}
+
+void uringReader_t::operator()(const fileEnumerator_t::fileBatch_t &, const consumer_t &, std::size_t &) {
+    throw std::runtime_error("io_uring is not supported");
+}
+
+#endif
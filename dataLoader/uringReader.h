@@ -0,0 +1,85 @@
+/**
+ * @file dataLoader/uringReader.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_URINGREADER_H
+#define TGNEWS_URINGREADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "fileEnumerator.h"
+
+struct io_uring_sqe;
+
+// Batched asynchronous file reader based on io_uring (raw syscalls, liburing is not required).
+// Up to queueDepth files of a batch are read at once: open and statx are issued together, read follows as soon as
+// both are completed, close is not awaited. Files are passed to the consumer in completion order, so the caller parses
+// a file while reads of the next ones are still in flight. Files are copied to the slot buffers, so it pays off on
+// a cold page cache or slow storage only, cached files are cheaper to map (mappedFile_t).
+// The reader is not thread safe, use one reader per thread.
+class uringReader_t final {
+public:
+    // files in flight
+    static const std::size_t queueDepth = 64;
+    // file buffers larger than this value are released after use, at most queueDepth * maxRetainedSize are kept
+    static const std::size_t maxRetainedSize = 256 * 1024;
+
+    // batch index of the file and its content, the content is valid till the consumer returns
+    using consumer_t = std::function<void(std::size_t _idx, const uint8_t *_data, std::size_t _size)>;
+
+    uringReader_t() noexcept;
+    ~uringReader_t();
+
+    uringReader_t(const uringReader_t &) = delete;
+    void operator=(const uringReader_t &) = delete;
+
+    // false if io_uring or one of the required operations is not supported by the kernel
+    [[nodiscard]] bool available() const noexcept {return m_fd >= 0;}
+
+    // reads all files of the batch, unreadable files are reported and skipped;
+    // returns number of issued syscalls via _syscalls
+    void operator()(const fileEnumerator_t::fileBatch_t &_batch,
+                    const consumer_t &_consumer,
+                    std::size_t &_syscalls);
+
+private:
+    struct slot_t;
+
+    int m_fd = -1;
+    void *m_sqRing = nullptr;
+    std::size_t m_sqRingSize = 0;
+    void *m_cqRing = nullptr;
+    std::size_t m_cqRingSize = 0;
+    void *m_sqes = nullptr;
+    std::size_t m_sqesSize = 0;
+
+    unsigned *m_sqTail = nullptr;
+    unsigned m_sqMask = 0;
+    unsigned *m_sqArray = nullptr;
+    unsigned *m_cqHead = nullptr;
+    unsigned *m_cqTail = nullptr;
+    unsigned m_cqMask = 0;
+    void *m_cqes = nullptr;
+    // prepared but not submitted entries
+    unsigned m_toSubmit = 0;
+
+    std::vector<slot_t> m_slots;
+
+    bool setup() noexcept;
+    void release() noexcept;
+
+    io_uring_sqe *sqe() noexcept;
+    void submit(std::size_t &_syscalls, bool _wait);
+
+    void start(slot_t &_slot);
+    void read(slot_t &_slot);
+    void finish(slot_t &_slot, const consumer_t &_consumer);
+};
+
+#endif //TGNEWS_URINGREADER_H
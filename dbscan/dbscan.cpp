@@ -8,12 +8,31 @@
 #include <cmath>
 #include <algorithm>
 
+#include "vecMath/vecMath.h"
 #include "dbscan.h"
 
-dbscan_t::dbscan_t(const std::vector<std::vector<float>> &_db, float _eps, uint8_t _minPts):
-        m_db(_db), m_threshold(_eps), m_minPts(_minPts), m_items(_db.size()) {
+dbscan_t::dbscan_t(const matrix_t &_db, float _eps, uint8_t _minPts):
+        dbscan_t(_db, nullptr, _eps, _minPts) {
+}
+
+dbscan_t::dbscan_t(const matrix_t &_db,
+                   const std::vector<uint32_t> &_rows,
+                   float _eps,
+                   uint8_t _minPts): dbscan_t(_db, &_rows, _eps, _minPts) {
+}
 
-    auto size = _db.size();
+dbscan_t::dbscan_t(const matrix_t &_db,
+                   const std::vector<uint32_t> *_rows,
+                   float _eps,
+                   uint8_t _minPts):
+        m_db(_db),
+        m_rows(_rows),
+        m_size((_rows == nullptr)?_db.rows():_rows->size()),
+        m_threshold(_eps),
+        m_minPts(_minPts),
+        m_items(m_size) {
+
+    auto size = m_size;
     if ((size >= 10) && (size < 20)) {
         m_threshold += 0.0f + (size - 10) * (0.00625f - 0.0f) / (20 - 10);
     } else if ((size >= 20) && (size < 40)) {
@@ -38,7 +57,7 @@ dbscan_t::dbscan_t(const std::vector<std::vector<float>> &_db, float _eps, uint8
 
     createSimilarityMatrix();
     for (uint8_t pts = m_minPts; pts > 0; --pts) {
-        for (std::size_t i = 0; i < _db.size(); ++i) {
+        for (std::size_t i = 0; i < m_size; ++i) {
             if (m_items[i].label != label_t::UNDEFINED) {
                 continue;
             }
@@ -99,12 +118,9 @@ dbscan_t::dbscan_t(const std::vector<std::vector<float>> &_db, float _eps, uint8
               });
 }
 
-float dbscan_t::distance(const std::vector<float> &_l, const std::vector<float> &_r) noexcept {
-    auto dst = 0.0f;
-    for (std::size_t i = 0; i < _l.size(); ++i) {
-        dst += _l[i] * _r[i];
-    }
-    return ((dst > 0.0f)?std::sqrt(dst / _l.size()):0.0f);
+float dbscan_t::distance(const float *_l, const float *_r) const noexcept {
+    auto dst = vecMath_t::dot(_l, _r, m_db.cols());
+    return ((dst > 0.0f)?std::sqrt(dst / m_db.cols()):0.0f);
 }
 
 void dbscan_t::baseRangeQuery(std::size_t _idx, std::vector<std::size_t> &_neighbors) {
@@ -116,13 +132,13 @@ void dbscan_t::baseRangeQuery(std::size_t _idx, std::vector<std::size_t> &_neigh
 }
 
 void dbscan_t::createSimilarityMatrix() {
-    if (m_db.empty()) {
+    if (m_size == 0) {
         return;
     }
 
-    for (std::size_t n = 0; n < m_db.size() - 1; ++n) {
-        for (std::size_t k = n + 1; k < m_db.size(); ++k) {
-            auto dst = distance(m_db[n], m_db[k]);
+    for (std::size_t n = 0; n < m_size - 1; ++n) {
+        for (std::size_t k = n + 1; k < m_size; ++k) {
+            auto dst = distance(item(n), item(k));
             if (dst < m_threshold) {
                 continue;
             }
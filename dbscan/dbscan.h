@@ -8,12 +8,17 @@
 #ifndef DBSCAN_DBSCAN_H
 #define DBSCAN_DBSCAN_H
 
+#include <cstdint>
 #include <vector>
 #include <map>
 
+#include "vecMath/matrix.h"
+
 class dbscan_t {
 public:
-    dbscan_t(const std::vector<std::vector<float>> &_db, float _eps, uint8_t _minPts);
+    dbscan_t(const matrix_t &_db, float _eps, uint8_t _minPts);
+    // clusters rows _rows[i] of _db, items of the result are indexes of _rows, vectors are not copied
+    dbscan_t(const matrix_t &_db, const std::vector<uint32_t> &_rows, float _eps, uint8_t _minPts);
     ~dbscan_t() = default;
 
     const auto &operator()() const noexcept {return m_clusters;}
@@ -30,7 +35,9 @@ private:
         std::size_t neighbors = 0;
         std::size_t clusterID = 0;
     };
-    const std::vector<std::vector<float>> &m_db;
+    const matrix_t &m_db;
+    const std::vector<uint32_t> *m_rows;
+    const std::size_t m_size;
     float m_threshold;
     const uint8_t m_minPts;
 
@@ -41,7 +48,15 @@ private:
     std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> m_clusters;
     uint64_t m_id = 0;
 
-    static float distance(const std::vector<float> &_l, const std::vector<float> &_r) noexcept;
+    dbscan_t(const matrix_t &_db,
+             const std::vector<uint32_t> *_rows,
+             float _eps,
+             uint8_t _minPts);
+
+    [[nodiscard]] const float *item(std::size_t _idx) const noexcept {
+        return (m_rows == nullptr)?m_db.row(_idx):m_db.row((*m_rows)[_idx]);
+    }
+    [[nodiscard]] float distance(const float *_l, const float *_r) const noexcept;
     void createSimilarityMatrix();
     void baseRangeQuery(std::size_t _idx, std::vector<std::size_t> &_neighbors);
 };
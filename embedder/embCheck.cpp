@@ -0,0 +1,134 @@
+/**
+ * @file embedder/embCheck.cpp
+ * @brief compares news detection, categories and clusters of a reference corpus embedded by two language models
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+
+#include "types.h"
+#include "dataLoader/dataLoader.h"
+#include "newsDetector/newsDetector.h"
+#include "categorizer/categorizer.h"
+#include "dbscan/dbscan.h"
+#include "embedder.h"
+
+static void usage(const char *_name) {
+    std::cout << _name << " lang reference_model model news_model category_model similarity_threshold tolerance path"
+              << std::endl
+              << "  fails if news labels, categories or clustered document pairs of the path documents differ by"
+              << std::endl
+              << "  more than the tolerance share, e.g. 0.01" << std::endl;
+}
+
+// document clusters by reference category, items are indexes of _rows
+static std::vector<std::size_t> clusters(const matrix_t &_vectors,
+                                         const std::vector<uint32_t> &_rows,
+                                         float _threshold) {
+    std::vector<std::size_t> ret(_rows.size(), 0);
+    dbscan_t dbscan(_vectors, _rows, _threshold, 32);
+    for (const auto &i:dbscan()) {
+        ret[std::get<1>(i)] = std::get<0>(i);
+    }
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 9) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const std::string lang = argv[1];
+        const auto threshold = std::stof(argv[6]);
+        const auto tolerance = std::stod(argv[7]);
+        auto threads = static_cast<uint8_t>(std::min(std::thread::hardware_concurrency(), 255u));
+
+        dataLoader_t dataLoader(threads, {lang}, argv + 8);
+        auto &docTable = dataLoader.docTable();
+        auto langDocs = dataLoader.langDocSet().find(lang);
+        if ((langDocs == dataLoader.langDocSet().end()) || langDocs->second.empty()) {
+            std::cerr << "no " << lang << " documents found" << std::endl;
+            return EXIT_FAILURE;
+        }
+        const auto &ids = langDocs->second;
+        // a row by document of ids
+        std::vector<uint32_t> rows(ids.size());
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            rows[i] = static_cast<uint32_t>(i);
+        }
+
+        matrix_t vectors[2];
+        std::vector<bool> news[2];
+        std::vector<categories_t> categories[2];
+        newsDetector_t newsDetector(argv[4]);
+        categorizer_t categorizer(argv[5]);
+        for (std::size_t m = 0; m < 2; ++m) {
+            embedder_t embedder(argv[2 + m]);
+            vectors[m].resize(ids.size(), embedder.vectorSize());
+            embedder(docTable.documents, ids, 0, ids.size(), vectors[m], rows);
+            newsDetector(vectors[m], 0, ids.size(), news[m]);
+            categorizer(vectors[m], 0, ids.size(), categories[m]);
+        }
+
+        std::size_t newsDiff = 0;
+        std::size_t categoryDiff = 0;
+        std::size_t newsCount = 0;
+        // rows by reference category
+        std::unordered_map<categories_t, std::vector<uint32_t>> groups;
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            newsDiff += (news[0][i] != news[1][i])?1:0;
+            if (!news[0][i]) {
+                continue;
+            }
+            ++newsCount;
+            categoryDiff += (categories[0][i] != categories[1][i])?1:0;
+            groups[categories[0][i]].emplace_back(rows[i]);
+        }
+
+        // documents are grouped by the reference news labels and categories, so only the vectors differ
+        std::size_t pairs = 0;
+        std::size_t pairDiff = 0;
+        for (const auto &g:groups) {
+            auto l = clusters(vectors[0], g.second, threshold);
+            auto r = clusters(vectors[1], g.second, threshold);
+            for (std::size_t i = 0; i < l.size(); ++i) {
+                for (std::size_t j = i + 1; j < l.size(); ++j) {
+                    auto lPair = (l[i] != 0) && (l[i] == l[j]);
+                    auto rPair = (r[i] != 0) && (r[i] == r[j]);
+                    pairs += (lPair || rPair)?1:0;
+                    pairDiff += (lPair != rPair)?1:0;
+                }
+            }
+        }
+
+        auto share = [](std::size_t _diff, std::size_t _total) {
+            return (_total > 0)?static_cast<double>(_diff) / static_cast<double>(_total):0.0;
+        };
+        auto newsShare = share(newsDiff, ids.size());
+        auto categoryShare = share(categoryDiff, newsCount);
+        auto pairShare = share(pairDiff, pairs);
+        std::cout << std::fixed << std::setprecision(4)
+                  << "documents: " << ids.size() << ", news: " << newsCount << std::endl
+                  << "news labels differ: " << newsDiff << " (" << newsShare << ")" << std::endl
+                  << "categories differ: " << categoryDiff << " (" << categoryShare << ")" << std::endl
+                  << "clustered pairs differ: " << pairDiff << " of " << pairs << " (" << pairShare << ")"
+                  << std::endl;
+
+        if ((newsShare > tolerance) || (categoryShare > tolerance) || (pairShare > tolerance)) {
+            std::cout << "FAILED, tolerance " << tolerance << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "PASSED, tolerance " << tolerance << std::endl;
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file embedder/embConvert.cpp
+ * @brief converts a language model to the embeddings file format, vectors may be quantized to fp16 or int8
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+#include "embeddings.h"
+
+static void usage(const char *_name) {
+    std::cout << _name << " model output [fp32|fp16|int8]" << std::endl
+              << "  model is a word2vec binary model (FAISS IVFPQ index in WITH_FAISS build) or an embeddings file,"
+              << std::endl
+              << "  vectors are stored as fp16 by default" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if ((argc < 3) || (argc > 4)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto type = embeddings_t::type_t::FP16;
+    if (argc == 4) {
+        std::string typeName = argv[3];
+        if (typeName == "fp32") {
+            type = embeddings_t::type_t::FP32;
+        } else if (typeName == "fp16") {
+            type = embeddings_t::type_t::FP16;
+        } else if (typeName == "int8") {
+            type = embeddings_t::type_t::INT8;
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        embeddings_t source(argv[1]);
+        source.save(argv[2], type);
+        embeddings_t result(argv[2]);
+
+        // quantization error, vectors are compared by every row
+        std::vector<float> l(source.vectorSize());
+        std::vector<float> r(source.vectorSize());
+        double maxError = 0.0;
+        double minCosine = 1.0;
+        double sumCosine = 0.0;
+        for (uint32_t i = 0; i < source.rows(); ++i) {
+            source.decode(i, l.data());
+            result.decode(i, r.data());
+            double dot = 0.0;
+            double ll = 0.0;
+            double rr = 0.0;
+            for (std::size_t j = 0; j < l.size(); ++j) {
+                maxError = std::max(maxError, static_cast<double>(std::fabs(l[j] - r[j])));
+                dot += static_cast<double>(l[j]) * r[j];
+                ll += static_cast<double>(l[j]) * l[j];
+                rr += static_cast<double>(r[j]) * r[j];
+            }
+            auto cosine = ((ll > 0.0) && (rr > 0.0))?dot / std::sqrt(ll * rr):1.0;
+            minCosine = std::min(minCosine, cosine);
+            sumCosine += cosine;
+        }
+
+        std::cout << "rows: " << source.rows() << ", vector size: " << source.vectorSize() << std::endl
+                  << "vectors: " << embeddings_t::name(source.type()) << " " << source.bytes() << " bytes -> "
+                  << embeddings_t::name(result.type()) << " " << result.bytes() << " bytes" << std::endl
+                  << std::setprecision(6)
+                  << "max abs error: " << maxError
+                  << ", cosine min: " << minCosine
+                  << ", mean: " << ((source.rows() > 0)?sumCosine / source.rows():1.0) << std::endl;
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
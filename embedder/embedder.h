@@ -8,37 +8,40 @@
 #ifndef TGNEWS_EMBEDDER_H
 #define TGNEWS_EMBEDDER_H
 
+#include <memory>
 #include <vector>
 
 #include "types.h"
+#include "textNormalizer.h"
 
-#ifdef WITH_FAISS
-namespace faiss {
-    struct IndexIVFPQ;
-}
-#else
-namespace w2v {
-    class w2vModel_t;
-}
-#endif
+class embeddings_t;
 
 class embedder_t {
 public:
-    explicit embedder_t(const std::string &_w2vLangModelFileName);
+    explicit embedder_t(const std::string &_w2vLangModelFileName,
+                        const embedderSettings_t &_settings = embedderSettings_t());
     ~embedder_t();
 
+    // embeds _documents[i], i = [_startFrom, _stopAt), to rows [0, _stopAt - _startFrom) of _result,
+    // the matrix is resized
     void operator()(const std::vector<document_t> &_documents,
                    std::size_t _startFrom, std::size_t _stopAt,
-                   std::vector<std::vector<float>> &_result) noexcept;
+                   matrix_t &_result) noexcept;
+    // embeds _documents[_ids[i]], i = [_startFrom, _stopAt), to the existing row _rows[i] of _vectors,
+    // documents are not copied
+    void operator()(const std::vector<document_t> &_documents,
+                    const docIds_t &_ids,
+                    std::size_t _startFrom, std::size_t _stopAt,
+                    matrix_t &_vectors,
+                    const std::vector<uint32_t> &_rows) noexcept;
     [[nodiscard]] uint16_t vectorSize() const noexcept;
 
 private:
-#ifdef WITH_FAISS
-    faiss::IndexIVFPQ *m_index;
-    std::unordered_map<std::string, int64_t> m_word2id;
-#else
-    std::unique_ptr<w2v::w2vModel_t> m_w2vModel;
-#endif
+    std::unique_ptr<embeddings_t> m_embeddings;
+    textNormalizer_t m_normalizer;
+
+    // _vector of vectorSize() floats
+    void embed(const document_t &_document, float *_vector);
 };
 
 #endif //TGNEWS_EMBEDDER_H
@@ -0,0 +1,417 @@
+/**
+ * @file embedder/embeddings.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+#include <new>
+#include <fstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include <mapper.hpp>
+
+#ifdef WITH_FAISS
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <faiss/index_io.h>
+#include <faiss/IndexIVFPQ.h>
+#pragma GCC diagnostic pop
+#endif
+
+#include "vecMath/vecMath.h"
+#include "embeddings.h"
+
+static const std::size_t cacheLine = 64;
+static const std::size_t hugePage = 2 * 1024 * 1024;
+static const std::size_t pageSize = 4096;
+
+// file layout: header, matrix (page aligned), INT8 scales, serialized vocabulary (8 bytes aligned);
+// the file is used in place, so it is readable by hosts of the same byte order only
+static const char fileMagic[8] = {'T', 'G', 'N', 'E', 'M', 'B', 'E', 'D'};
+static const uint32_t fileVersion = 2;
+
+struct fileHeader_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t type;
+    uint64_t rows;
+    uint32_t vectorSize;
+    uint32_t stride;
+    uint64_t matrixOffset;
+    uint64_t scalesOffset;
+    uint64_t vocabularyOffset;
+    uint64_t vocabularySize;
+};
+
+static inline std::size_t alignUp(std::size_t _value, std::size_t _alignment) noexcept {
+    return (_value + _alignment - 1) / _alignment * _alignment;
+}
+
+static inline std::size_t elementSize(embeddings_t::type_t _type) noexcept {
+    switch (_type) {
+        case embeddings_t::type_t::FP16:
+            return sizeof(uint16_t);
+        case embeddings_t::type_t::INT8:
+            return sizeof(int8_t);
+        default:
+            return sizeof(float);
+    }
+}
+
+void embeddings_t::deleter_t::operator()(uint8_t *_ptr) const noexcept {
+    std::free(_ptr);
+}
+
+embeddings_t::embeddings_t(const std::string &_modelFileName,
+                           [[maybe_unused]] const embedderSettings_t &_settings) {
+    if (isEmbeddingsFile(_modelFileName)) {
+        load(_modelFileName);
+    } else {
+#ifdef WITH_FAISS
+        loadFaiss(_modelFileName, _settings);
+#else
+        loadW2v(_modelFileName);
+#endif
+    }
+    m_vocabulary.shrink();
+}
+
+embeddings_t::~embeddings_t() {
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_mappingSize);
+    }
+}
+
+std::size_t embeddings_t::bytes() const noexcept {
+    return m_decodedRows * m_stride + ((m_type == type_t::INT8)?m_decodedRows * sizeof(float):0);
+}
+
+void embeddings_t::accumulate(float *_dst, uint32_t _idx) const noexcept {
+#ifdef WITH_FAISS
+    if (_idx >= m_decodedRows) {
+        accumulateIndex(_dst, _idx);
+        return;
+    }
+#endif
+    switch (m_type) {
+        case type_t::FP16:
+            vecMath_t::accumulateFp16(_dst, reinterpret_cast<const uint16_t *>(row(_idx)), m_vectorSize);
+            break;
+        case type_t::INT8:
+            vecMath_t::accumulateInt8(_dst, reinterpret_cast<const int8_t *>(row(_idx)), m_scales[_idx], m_vectorSize);
+            break;
+        default:
+            vecMath_t::accumulate(_dst, reinterpret_cast<const float *>(row(_idx)), m_vectorSize);
+            break;
+    }
+}
+
+void embeddings_t::decode(uint32_t _idx, float *_dst) const noexcept {
+    std::fill(_dst, _dst + m_vectorSize, 0.0f);
+    accumulate(_dst, _idx);
+}
+
+bool embeddings_t::isEmbeddingsFile(const std::string &_fileName) noexcept {
+    std::ifstream ifs(_fileName, std::ios::binary);
+    char magic[sizeof(fileMagic)];
+    return ifs.read(magic, sizeof(magic)) && (std::memcmp(magic, fileMagic, sizeof(magic)) == 0);
+}
+
+const char *embeddings_t::name(type_t _type) noexcept {
+    switch (_type) {
+        case type_t::FP16:
+            return "fp16";
+        case type_t::INT8:
+            return "int8";
+        default:
+            return "fp32";
+    }
+}
+
+uint8_t *embeddings_t::allocate(type_t _type, std::size_t _rows, uint16_t _vectorSize) {
+    m_type = _type;
+    m_rows = _rows;
+    m_decodedRows = _rows;
+    m_vectorSize = _vectorSize;
+    m_stride = alignUp(_vectorSize * elementSize(_type), cacheLine);
+    m_scalesStorage.assign((_type == type_t::INT8)?_rows:0, 0.0f);
+    m_scales = m_scalesStorage.data();
+
+    // large matrices are huge page aligned, so the kernel may back them by huge pages (fewer TLB misses)
+    auto bytes = std::max<std::size_t>(m_rows * m_stride, 1);
+    auto alignment = (bytes >= hugePage)?hugePage:cacheLine;
+    bytes = alignUp(bytes, alignment);
+    m_matrixStorage.reset(static_cast<uint8_t *>(std::aligned_alloc(alignment, bytes)));
+    if (!m_matrixStorage) {
+        throw std::bad_alloc();
+    }
+#ifdef __linux__
+    if (alignment == hugePage) {
+        madvise(m_matrixStorage.get(), bytes, MADV_HUGEPAGE);
+    }
+#endif
+    std::memset(m_matrixStorage.get(), 0, bytes);
+    m_matrix = m_matrixStorage.get();
+
+    return m_matrixStorage.get();
+}
+
+void embeddings_t::save(const std::string &_fileName, type_t _type) const {
+    fileHeader_t header{};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.type = static_cast<uint32_t>(_type);
+    header.rows = m_rows;
+    header.vectorSize = m_vectorSize;
+    header.stride = static_cast<uint32_t>(alignUp(m_vectorSize * elementSize(_type), cacheLine));
+    header.matrixOffset = alignUp(sizeof(header), pageSize);
+    header.scalesOffset = header.matrixOffset + header.rows * header.stride;
+    header.vocabularyOffset = alignUp(header.scalesOffset + ((_type == type_t::INT8)?header.rows * sizeof(float):0),
+                                      sizeof(uint64_t));
+    header.vocabularySize = m_vocabulary.serializedSize();
+
+    std::ofstream ofs(_fileName, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+        throw std::runtime_error("failed to create file " + _fileName);
+    }
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    std::vector<char> padding(header.matrixOffset - sizeof(header), 0);
+    ofs.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+    std::vector<float> vec(m_vectorSize);
+    std::vector<float> scales;
+    std::vector<uint8_t> out(header.stride);
+    for (uint32_t i = 0; i < m_rows; ++i) {
+        decode(i, vec.data());
+        std::fill(out.begin(), out.end(), 0);
+        switch (_type) {
+            case type_t::FP16: {
+                auto dst = reinterpret_cast<uint16_t *>(out.data());
+                for (std::size_t j = 0; j < m_vectorSize; ++j) {
+                    dst[j] = vecMath_t::toFp16(vec[j]);
+                }
+                break;
+            }
+            case type_t::INT8: {
+                // symmetric, the largest magnitude of the row maps to 127
+                auto maxAbs = 0.0f;
+                for (auto v:vec) {
+                    maxAbs = std::max(maxAbs, std::fabs(v));
+                }
+                auto scale = maxAbs / 127.0f;
+                auto dst = reinterpret_cast<int8_t *>(out.data());
+                for (std::size_t j = 0; (j < m_vectorSize) && (scale > 0.0f); ++j) {
+                    dst[j] = static_cast<int8_t>(std::lround(std::clamp(vec[j] / scale, -127.0f, 127.0f)));
+                }
+                scales.emplace_back(scale);
+                break;
+            }
+            default:
+                std::memcpy(out.data(), vec.data(), vec.size() * sizeof(float));
+                break;
+        }
+        ofs.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size()));
+    }
+    ofs.write(reinterpret_cast<const char *>(scales.data()),
+              static_cast<std::streamsize>(scales.size() * sizeof(float)));
+    padding.assign(header.vocabularyOffset - header.scalesOffset - scales.size() * sizeof(float), 0);
+    ofs.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    // vocabulary values are row indexes, so the table is written as is
+    std::vector<uint64_t> vocabulary(header.vocabularySize / sizeof(uint64_t));
+    m_vocabulary.serialize(reinterpret_cast<uint8_t *>(vocabulary.data()));
+    ofs.write(reinterpret_cast<const char *>(vocabulary.data()), static_cast<std::streamsize>(header.vocabularySize));
+
+    if (!ofs.flush()) {
+        throw std::runtime_error("failed to write file " + _fileName);
+    }
+}
+
+void embeddings_t::load(const std::string &_fileName) {
+    auto fd = ::open(_fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("failed to open file " + _fileName);
+    }
+    struct stat st {};
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+        ::close(fd);
+        throw std::runtime_error("failed to read file " + _fileName);
+    }
+    auto size = static_cast<std::size_t>(st.st_size);
+    // shared read-only mapping, pages are taken from the page cache and shared by all processes using the file
+    auto mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("failed to map file " + _fileName);
+    }
+    try {
+        attach(static_cast<const uint8_t *>(mapping), size, _fileName);
+    } catch (...) {
+        munmap(mapping, size);
+        throw;
+    }
+    m_mapping = mapping;
+    m_mappingSize = size;
+}
+
+void embeddings_t::attach(const uint8_t *_data, std::size_t _size, const std::string &_fileName) {
+    auto wrongFormat = [&_fileName]() {
+        return std::runtime_error("wrong embeddings file format, file " + _fileName);
+    };
+
+    fileHeader_t header{};
+    if (_size < sizeof(header)) {
+        throw wrongFormat();
+    }
+    std::memcpy(&header, _data, sizeof(header));
+    if ((header.version != fileVersion)
+        || (header.type > static_cast<uint32_t>(type_t::INT8))
+        || (header.vectorSize == 0) || (header.vectorSize > UINT16_MAX)) {
+        throw wrongFormat();
+    }
+    m_type = static_cast<type_t>(header.type);
+    m_rows = header.rows;
+    m_decodedRows = m_rows;
+    m_vectorSize = static_cast<uint16_t>(header.vectorSize);
+    m_stride = alignUp(m_vectorSize * elementSize(m_type), cacheLine);
+    auto scalesSize = (m_type == type_t::INT8)?m_rows * sizeof(float):0;
+    if ((header.stride != m_stride)
+        || (header.matrixOffset % pageSize != 0)
+        || (header.matrixOffset + m_rows * m_stride > _size)
+        || (header.scalesOffset % sizeof(float) != 0)
+        || (header.scalesOffset + scalesSize > _size)
+        || (header.vocabularyOffset % sizeof(uint64_t) != 0)
+        || (header.vocabularyOffset + header.vocabularySize > _size)) {
+        throw wrongFormat();
+    }
+    m_matrix = _data + header.matrixOffset;
+    m_scales = reinterpret_cast<const float *>(_data + header.scalesOffset);
+    m_vocabulary.attach(_data + header.vocabularyOffset, header.vocabularySize, m_rows);
+    // every token probes the vocabulary, it is prefetched
+    auto vocabulary = header.vocabularyOffset / pageSize * pageSize;
+    madvise(const_cast<uint8_t *>(_data) + vocabulary, _size - vocabulary, MADV_WILLNEED);
+}
+
+#ifdef WITH_FAISS
+void embeddings_t::loadFaiss(const std::string &_indexFileName, const embedderSettings_t &_settings) {
+    // the index is read from the file directly, not through a copy of the whole file in memory
+    std::unique_ptr<faiss::Index> anyIndex(faiss::read_index(_indexFileName.c_str()));
+    std::unique_ptr<faiss::IndexIVFPQ> index(dynamic_cast<faiss::IndexIVFPQ *>(anyIndex.get()));
+    if (!index) {
+        throw std::runtime_error("unknown index format, file " + _indexFileName);
+    }
+    anyIndex.release();
+    index->make_direct_map(true);
+
+    // line number in the words file is the index id, words are sorted by frequency, so the first rows are decoded
+    w2v::fileMapper_t fileMapper(_indexFileName + ".map");
+    std::string_view words(fileMapper.data(), fileMapper.size());
+    auto rows = static_cast<std::size_t>(index->ntotal);
+    auto decodedRows = (_settings.decodedWords == 0)?rows:std::min(rows, _settings.decodedWords);
+    auto matrix = allocate(_settings.decodedFp16?type_t::FP16:type_t::FP32,
+                           decodedRows, static_cast<uint16_t>(index->d));
+    m_rows = rows;
+    std::vector<float> vec(m_vectorSize);
+    uint32_t id = 0;
+    while (!words.empty()) {
+        auto eol = words.find('\n');
+        auto word = words.substr(0, eol);
+        words.remove_prefix((eol == std::string_view::npos)?words.size():eol + 1);
+        if (word.empty()) {
+            continue;
+        }
+        if (id >= m_rows) {
+            throw std::runtime_error("words file does not match the index, file " + _indexFileName + ".map");
+        }
+        m_vocabulary.insert(word, id);
+        if (id < m_decodedRows) {
+            index->reconstruct(id, vec.data());
+            if (m_type == type_t::FP16) {
+                auto dst = reinterpret_cast<uint16_t *>(matrix + id * m_stride);
+                for (std::size_t j = 0; j < m_vectorSize; ++j) {
+                    dst[j] = vecMath_t::toFp16(vec[j]);
+                }
+            } else {
+                std::memcpy(matrix + id * m_stride, vec.data(), vec.size() * sizeof(float));
+            }
+        }
+        ++id;
+    }
+
+    if (m_decodedRows < m_rows) {
+        m_index = std::move(index);
+    }
+}
+
+void embeddings_t::accumulateIndex(float *_dst, uint32_t _idx) const noexcept {
+    // reconstruct() is const and keeps no state, so the index is shared by threads, the buffer is per thread
+    thread_local std::vector<float> vec;
+    try {
+        vec.resize(m_vectorSize);
+        m_index->reconstruct(_idx, vec.data());
+    } catch (...) {
+        return;
+    }
+    vecMath_t::accumulate(_dst, vec.data(), m_vectorSize);
+}
+#else
+// word2vec binary format: "words vectorSize\n", then "word " followed by vectorSize floats for every word,
+// words may be prefixed by '\n'. Vectors are normalized by their RMS as w2v::w2vModel_t::load() does.
+void embeddings_t::loadW2v(const std::string &_modelFileName) {
+    w2v::fileMapper_t fileMapper(_modelFileName);
+    std::string_view data(fileMapper.data(), static_cast<std::size_t>(fileMapper.size()));
+    auto wrongFormat = [&_modelFileName]() {
+        return std::runtime_error("wrong model file format, file " + _modelFileName);
+    };
+
+    auto eol = data.find('\n');
+    if (eol == std::string_view::npos) {
+        throw wrongFormat();
+    }
+    char *end = nullptr;
+    std::string header(data.substr(0, eol));
+    auto words = std::strtoull(header.c_str(), &end, 10);
+    auto vectorSize = std::strtoul(end, &end, 10);
+    if ((words == 0) || (vectorSize == 0) || (vectorSize > UINT16_MAX)) {
+        throw wrongFormat();
+    }
+    data.remove_prefix(eol + 1);
+
+    auto matrix = allocate(type_t::FP32, words, static_cast<uint16_t>(vectorSize));
+    auto vectorBytes = vectorSize * sizeof(float);
+    for (std::size_t i = 0; i < m_rows; ++i) {
+        while (!data.empty() && (data.front() == '\n')) {
+            data.remove_prefix(1);
+        }
+        auto space = data.find(' ');
+        if ((space == std::string_view::npos) || (data.size() - space - 1 < vectorBytes)) {
+            throw wrongFormat();
+        }
+        auto row = reinterpret_cast<float *>(matrix + i * m_stride);
+        std::memcpy(row, data.data() + space + 1, vectorBytes);
+        m_vocabulary.insert(data.substr(0, space), static_cast<uint32_t>(i));
+        data.remove_prefix(space + 1 + vectorBytes);
+
+        float med = 0.0f;
+        for (std::size_t j = 0; j < vectorSize; ++j) {
+            med += row[j] * row[j];
+        }
+        if (med <= 0.0f) {
+            continue;
+        }
+        med = std::sqrt(med / vectorSize);
+        for (std::size_t j = 0; j < vectorSize; ++j) {
+            row[j] /= med;
+        }
+    }
+}
+#endif
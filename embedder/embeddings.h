@@ -0,0 +1,110 @@
+/**
+ * @file embedder/embeddings.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_EMBEDDINGS_H
+#define TGNEWS_EMBEDDINGS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.h"
+#include "vocabulary.h"
+
+#ifdef WITH_FAISS
+namespace faiss {
+    struct IndexIVFPQ;
+}
+#endif
+
+// Word vectors in a single cache line aligned row-major matrix. Rows follow the model order, word2vec models are
+// sorted by word frequency, so vectors of frequent words share pages.
+// Built from a word2vec binary model, (WITH_FAISS) from an IVFPQ index and its ".map" words file, or from an
+// embeddings file written by save(), which is detected by its header. Vectors of an embeddings file may be stored
+// as half precision floats or as int8 scaled per row, they are dequantized on accumulation.
+// Embeddings files are memory mapped read-only and used in place, vectors and the vocabulary are not copied, so the
+// load is almost free on a warm page cache and processes using the same file share its physical memory.
+// (WITH_FAISS) Only the embedderSettings_t::decodedWords most frequent index vectors may be decoded at load, as fp32
+// or fp16, vectors of the rest of the words are decoded from the index on accumulation.
+class embeddings_t final {
+public:
+    enum class type_t : uint32_t {
+        FP32 = 0,
+        FP16 = 1,
+        INT8 = 2
+    };
+
+    explicit embeddings_t(const std::string &_modelFileName,
+                          const embedderSettings_t &_settings = embedderSettings_t());
+    ~embeddings_t();
+
+    embeddings_t(const embeddings_t &) = delete;
+    void operator=(const embeddings_t &) = delete;
+
+    // returns row index of the word or vocabulary_t::npos
+    [[nodiscard]] uint32_t find(std::string_view _word) const noexcept {return m_vocabulary.find(_word);}
+    // _dst[i] += row[i], i = [0, vectorSize())
+    void accumulate(float *_dst, uint32_t _idx) const noexcept;
+    // _dst[i] = row[i]
+    void decode(uint32_t _idx, float *_dst) const noexcept;
+    [[nodiscard]] uint16_t vectorSize() const noexcept {return m_vectorSize;}
+    [[nodiscard]] std::size_t rows() const noexcept {return m_rows;}
+    [[nodiscard]] type_t type() const noexcept {return m_type;}
+    // matrix and scales size, (WITH_FAISS) the index is not counted
+    [[nodiscard]] std::size_t bytes() const noexcept;
+    // true if used in place of a mapped embeddings file
+    [[nodiscard]] bool mapped() const noexcept {return m_mapping != nullptr;}
+
+    // writes the embeddings file, vectors are quantized to _type
+    void save(const std::string &_fileName, type_t _type) const;
+
+    static bool isEmbeddingsFile(const std::string &_fileName) noexcept;
+    static const char *name(type_t _type) noexcept;
+
+private:
+    struct deleter_t {
+        void operator()(uint8_t *_ptr) const noexcept;
+    };
+
+    vocabulary_t m_vocabulary;
+    // the matrix and INT8 dequantization factors by row, point either to the storage or to the mapped file
+    const uint8_t *m_matrix = nullptr;
+    const float *m_scales = nullptr;
+    std::unique_ptr<uint8_t[], deleter_t> m_matrixStorage;
+    std::vector<float> m_scalesStorage;
+    void *m_mapping = nullptr;
+    std::size_t m_mappingSize = 0;
+    type_t m_type = type_t::FP32;
+    std::size_t m_rows = 0;
+    // rows of the matrix, the rest are decoded from the index
+    std::size_t m_decodedRows = 0;
+    uint16_t m_vectorSize = 0;
+    // row size in bytes, rows are padded to the cache line
+    std::size_t m_stride = 0;
+#ifdef WITH_FAISS
+    // kept if not all vectors are decoded
+    std::unique_ptr<faiss::IndexIVFPQ> m_index;
+#endif
+
+    [[nodiscard]] const uint8_t *row(uint32_t _idx) const noexcept {return m_matrix + _idx * m_stride;}
+    // returns the matrix storage
+    uint8_t *allocate(type_t _type, std::size_t _rows, uint16_t _vectorSize);
+    void load(const std::string &_fileName);
+    // uses the embeddings file content in place
+    void attach(const uint8_t *_data, std::size_t _size, const std::string &_fileName);
+#ifdef WITH_FAISS
+    void loadFaiss(const std::string &_indexFileName, const embedderSettings_t &_settings);
+    // decodes the vector from the index, thread safe
+    void accumulateIndex(float *_dst, uint32_t _idx) const noexcept;
+#else
+    void loadW2v(const std::string &_modelFileName);
+#endif
+};
+
+#endif //TGNEWS_EMBEDDINGS_H
@@ -0,0 +1,105 @@
+/**
+ * @file embedder/embeddingsBench.cpp
+ * @brief word vectors accumulation throughput by the number of decoded FAISS index vectors
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "textNormalizer.h"
+#include "tokenizer.h"
+#include "embeddings.h"
+
+// runs _pass until _seconds elapsed, returns tokens/s
+template<typename pass_t>
+static double measure(const pass_t &_pass, double _seconds) {
+    std::size_t tokens = 0;
+    auto started = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < _seconds) {
+        tokens += _pass();
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    return static_cast<double>(tokens) / elapsed;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " model text_file [decoded_words ...]" << std::endl
+                  << "  decoded_words 0 - all index vectors are decoded at load (default)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string raw;
+    {
+        std::ifstream ifs(argv[2]);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        raw = ss.str();
+    }
+    std::string text;
+    textNormalizer_t normalizer;
+    normalizer(raw, text);
+
+    std::vector<std::size_t> decodedWords;
+    for (int i = 3; i < argc; ++i) {
+        decodedWords.emplace_back(std::stoull(argv[i]));
+    }
+    if (decodedWords.empty()) {
+        decodedWords.emplace_back(0);
+    }
+#ifndef WITH_FAISS
+    std::cout << "not a WITH_FAISS build, all vectors are decoded at load" << std::endl;
+#endif
+
+    try {
+        std::cout << std::fixed << std::setprecision(2);
+        for (auto words:decodedWords) {
+            for (auto fp16:{false, true}) {
+                embedderSettings_t settings;
+                settings.decodedWords = words;
+                settings.decodedFp16 = fp16;
+                auto loadStarted = std::chrono::steady_clock::now();
+                embeddings_t embeddings(argv[1], settings);
+                std::chrono::duration<double> load = std::chrono::steady_clock::now() - loadStarted;
+
+                std::vector<float> vec(embeddings.vectorSize());
+                volatile float sink = 0.0f;
+                auto tokensPerSecond = measure([&] {
+                    std::fill(vec.begin(), vec.end(), 0.0f);
+                    tokenizer_t tokenizer(text);
+                    std::size_t tokens = 0;
+                    std::string_view word;
+                    while (tokenizer.next(word)) {
+                        ++tokens;
+                        auto idx = embeddings.find(word);
+                        if (idx != vocabulary_t::npos) {
+                            embeddings.accumulate(vec.data(), idx);
+                        }
+                    }
+                    sink = sink + vec[0];
+                    return tokens;
+                }, 2.0);
+
+                std::cout << "decoded " << std::setw(8) << ((words == 0)?std::string("all"):std::to_string(words))
+                          << std::setw(6) << embeddings_t::name(embeddings.type())
+                          << ", matrix " << std::setw(10) << embeddings.bytes() << " bytes"
+                          << ", load " << std::setw(7) << load.count() << " s, "
+                          << std::setw(7) << tokensPerSecond / 1e6 << " Mtokens/s" << std::endl;
+            }
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file embedder/textNormalizer.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <unicode/unistr.h>
+#include <unicode/uchar.h>
+
+#include "textNormalizer.h"
+
+// greek capital sigma is lowercased depending on its position in a word
+static const UChar32 capitalSigma = 0x03a3;
+// combining dot above changes lowercasing of 'I' in some locales
+static const UChar32 combiningDotAbove = 0x0307;
+
+static inline bool delimiter(UChar _c) noexcept {
+    return (_c == '.') || (_c == '\n') || (_c == '?') || (_c == '!');
+}
+
+// case mapping contexts do not span ASCII white spaces, so words are passed to ICU independently
+static inline bool whiteSpace(char _c) noexcept {
+    return (_c == ' ') || (_c == '\n') || (_c == '\t') || (_c == '\r') || (_c == '\v') || (_c == '\f');
+}
+
+static inline void normalize(icu::UnicodeString &_ucs) {
+    _ucs.toLower();
+    for (int32_t i = 0; i < _ucs.length(); ++i) {
+        auto c = _ucs.charAt(i);
+        if (!u_isalpha(c) && !delimiter(c)) {
+            _ucs.setCharAt(i, ' ');
+        }
+    }
+}
+
+textNormalizer_t::textNormalizer_t() {
+    for (UChar32 c = 0; c < static_cast<UChar32>(tableSize); ++c) {
+        if ((c == capitalSigma) || (c == combiningDotAbove)) {
+            continue;
+        }
+        icu::UnicodeString ucs(c);
+        normalize(ucs);
+        std::string utf8;
+        ucs.toUTF8String(utf8);
+        if (utf8.size() > sizeof(m_table[c].bytes)) {
+            continue;
+        }
+        m_table[c].size = static_cast<uint8_t>(utf8.size());
+        utf8.copy(m_table[c].bytes, utf8.size());
+    }
+}
+
+void textNormalizer_t::operator()(std::string_view _text, std::string &_result) const {
+    auto data = reinterpret_cast<const uint8_t *>(_text.data());
+    auto size = _text.size();
+    // a mapping is at most 1.5 times longer than its sequence, the buffer is only resized after ICU calls
+    auto pos = _result.size();
+    _result.resize(pos + size + size / 2);
+    // current word start in _text and in _result
+    std::size_t wordStart = 0;
+    auto resultWordStart = pos;
+    std::size_t i = 0;
+    while (i < size) {
+        const mapping_t *mapping = nullptr;
+        std::size_t length = 1;
+        if (data[i] < 0x80) {
+            mapping = &m_table[data[i]];
+        } else if ((data[i] >= 0xc2) && (data[i] <= 0xdf) && (i + 1 < size) && ((data[i + 1] & 0xc0) == 0x80)) {
+            mapping = &m_table[((data[i] & 0x1fu) << 6) | (data[i + 1] & 0x3fu)];
+            length = 2;
+        }
+
+        if ((mapping != nullptr) && (mapping->size > 0)) {
+            auto out = &_result[pos];
+            out[0] = mapping->bytes[0];
+            if (mapping->size > 1) {
+                out[1] = mapping->bytes[1];
+                out[2] = mapping->bytes[2];
+            }
+            pos += mapping->size;
+            i += length;
+            if ((length == 1) && whiteSpace(static_cast<char>(data[i - 1]))) {
+                wordStart = i;
+                resultWordStart = pos;
+            }
+            continue;
+        }
+
+        // the whole word is normalized by ICU
+        auto wordEnd = i;
+        while ((wordEnd < size) && !whiteSpace(static_cast<char>(data[wordEnd]))) {
+            ++wordEnd;
+        }
+        _result.resize(resultWordStart);
+        fallback(_text.substr(wordStart, wordEnd - wordStart), _result);
+        i = wordEnd;
+        wordStart = i;
+        pos = _result.size();
+        resultWordStart = pos;
+        _result.resize(pos + (size - i) + (size - i) / 2);
+    }
+    _result.resize(pos);
+}
+
+void textNormalizer_t::fallback(std::string_view _word, std::string &_result) {
+    auto ucs = icu::UnicodeString::fromUTF8(icu::StringPiece(_word.data(), static_cast<int32_t>(_word.size())));
+    normalize(ucs);
+    ucs.toUTF8String(_result);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file embedder/textNormalizer.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_TEXTNORMALIZER_H
+#define TGNEWS_TEXTNORMALIZER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Lowercases UTF-8 text and replaces everything but letters and sentence delimiters ('.', '\n', '?', '!') by
+// spaces in a single pass, the result is the same as of icu::UnicodeString::toLower() followed by u_isalpha() test
+// of every UTF-16 code unit.
+// One and two byte sequences (Latin, Greek, Cyrillic, ...) are mapped by a table built at startup, words with other
+// scripts, context dependent mappings (final sigma) or invalid sequences are passed to ICU.
+class textNormalizer_t final {
+public:
+    textNormalizer_t();
+
+    textNormalizer_t(const textNormalizer_t &) = delete;
+    void operator=(const textNormalizer_t &) = delete;
+
+    // appends normalized _text to _result
+    void operator()(std::string_view _text, std::string &_result) const;
+
+private:
+    // UTF-8 of the normalized code point, size 0 - ICU is required
+    struct mapping_t {
+        uint8_t size = 0;
+        char bytes[3] = {0, 0, 0};
+    };
+
+    // U+0000 - U+07FF, all one and two byte sequences
+    static const std::size_t tableSize = 0x800;
+    mapping_t m_table[tableSize];
+
+    static void fallback(std::string_view _word, std::string &_result);
+};
+
+#endif //TGNEWS_TEXTNORMALIZER_H
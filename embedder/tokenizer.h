@@ -0,0 +1,61 @@
+/**
+ * @file embedder/tokenizer.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_TOKENIZER_H
+#define TGNEWS_TOKENIZER_H
+
+#include <cstdint>
+#include <string_view>
+
+// 256 bit set of delimiter bytes, the same set the w2v word reader was configured with
+struct wordDelimiters_t {
+    uint64_t bits[4] = {0, 0, 0, 0};
+
+    constexpr wordDelimiters_t() noexcept {
+        for (auto c:std::string_view(" \n,.-!?:;/\"#$%&'()*+<=>@[]\\^_`{|}~\t\v\f\r")) {
+            auto b = static_cast<uint8_t>(c);
+            bits[b >> 6] |= 1ULL << (b & 63);
+        }
+    }
+    [[nodiscard]] constexpr bool test(uint8_t _c) const noexcept {
+        return (bits[_c >> 6] >> (_c & 63)) & 1;
+    }
+};
+
+// Splits a normalized text into words, tokens are views of the text, nothing is copied or allocated.
+// All delimiters are ASCII, so UTF-8 sequences are never split. Empty tokens are skipped.
+class tokenizer_t final {
+public:
+    explicit tokenizer_t(std::string_view _text) noexcept: m_text(_text) {}
+
+    // returns false at the end of the text
+    bool next(std::string_view &_token) noexcept {
+        auto data = reinterpret_cast<const uint8_t *>(m_text.data());
+        auto size = m_text.size();
+        while ((m_pos < size) && delimiters.test(data[m_pos])) {
+            ++m_pos;
+        }
+        if (m_pos == size) {
+            return false;
+        }
+        auto start = m_pos;
+        while ((m_pos < size) && !delimiters.test(data[m_pos])) {
+            ++m_pos;
+        }
+        _token = m_text.substr(start, m_pos - start);
+
+        return true;
+    }
+
+private:
+    static constexpr wordDelimiters_t delimiters{};
+
+    std::string_view m_text;
+    std::size_t m_pos = 0;
+};
+
+#endif //TGNEWS_TOKENIZER_H
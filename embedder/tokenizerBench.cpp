@@ -0,0 +1,114 @@
+/**
+ * @file embedder/tokenizerBench.cpp
+ * @brief tokenization and vocabulary lookup throughput, w2v word reader vs tokenizer_t
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <mapper.hpp>
+#include <wordReader.hpp>
+
+#include "textNormalizer.h"
+#include "tokenizer.h"
+#include "vocabulary.h"
+
+static const char *wordDelimiters = " \n,.-!?:;/\"#$%&'()*+<=>@[]\\^_`{|}~\t\v\f\r";
+
+// runs _pass until _seconds elapsed, returns tokens/s
+template<typename pass_t>
+static double measure(const pass_t &_pass, double _seconds) {
+    std::size_t tokens = 0;
+    auto started = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < _seconds) {
+        tokens += _pass();
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    return static_cast<double>(tokens) / elapsed;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " text_file" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string raw;
+    {
+        std::ifstream ifs(argv[1]);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        raw = ss.str();
+    }
+    std::string text;
+    textNormalizer_t normalizer;
+    normalizer(raw, text);
+
+    // every other distinct word is in the vocabulary, so half of the lookups miss
+    std::unordered_map<std::string, int64_t> word2id;
+    vocabulary_t vocabulary;
+    {
+        std::unordered_map<std::string, bool> seen;
+        tokenizer_t tokenizer(text);
+        std::string_view word;
+        while (tokenizer.next(word)) {
+            auto s = seen.emplace(std::string(word), seen.size() % 2 == 0);
+            if (s.second && s.first->second) {
+                word2id.emplace(std::string(word), word2id.size());
+                vocabulary.insert(word, static_cast<uint32_t>(vocabulary.size()));
+            }
+        }
+        vocabulary.shrink();
+    }
+
+    volatile uint64_t sink = 0;
+    auto wordReader = measure([&] {
+        w2v::stringMapper_t stringMapper(text);
+        w2v::wordReader_t<w2v::stringMapper_t> reader(stringMapper, wordDelimiters, "");
+        std::size_t tokens = 0;
+        std::string word;
+        while (reader.nextWord(word)) {
+            if (word.empty()) {
+                continue;
+            }
+            ++tokens;
+            auto w2id = word2id.find(word);
+            if (w2id != word2id.end()) {
+                sink = sink + static_cast<uint64_t>(w2id->second);
+            }
+        }
+        return tokens;
+    }, 2.0);
+
+    auto tokenizer = measure([&] {
+        tokenizer_t tokenizer(text);
+        std::size_t tokens = 0;
+        std::string_view word;
+        while (tokenizer.next(word)) {
+            ++tokens;
+            auto idx = vocabulary.find(word);
+            if (idx != vocabulary_t::npos) {
+                sink = sink + idx;
+            }
+        }
+        return tokens;
+    }, 2.0);
+
+    std::cout << "text " << text.size() << " bytes, vocabulary " << vocabulary.size() << " words" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(28) << "wordReader + unordered_map" << std::setw(10) << wordReader / 1e6 << " Mtokens/s"
+              << std::endl
+              << std::setw(28) << "tokenizer + vocabulary" << std::setw(10) << tokenizer / 1e6 << " Mtokens/s"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
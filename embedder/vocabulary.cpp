@@ -0,0 +1,220 @@
+/**
+ * @file embedder/vocabulary.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "vocabulary.h"
+
+static const std::size_t minSlots = 1024;
+
+static inline std::size_t align8(std::size_t _value) noexcept {
+    return (_value + 7) & ~static_cast<std::size_t>(7);
+}
+
+static inline uint64_t mix(uint64_t _h) noexcept {
+    _h ^= _h >> 32;
+    _h *= 0xd6e8feb86659fd93ULL;
+    _h ^= _h >> 32;
+    return _h;
+}
+
+// words are short, so 8 bytes are hashed at once and the tail is read by a single load
+uint64_t vocabulary_t::hash(std::string_view _word) noexcept {
+    auto data = _word.data();
+    auto size = _word.size();
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+    while (size >= 8) {
+        uint64_t w;
+        std::memcpy(&w, data, 8);
+        h = mix(h ^ w) * 0x9e3779b97f4a7c15ULL;
+        data += 8;
+        size -= 8;
+    }
+    if (size > 0) {
+        uint64_t w = 0;
+        std::memcpy(&w, data, size);
+        h = mix(h ^ w) * 0x9e3779b97f4a7c15ULL;
+    }
+
+    return mix(h);
+}
+
+void vocabulary_t::insert(std::string_view _word, uint32_t _value) {
+    if (m_attached) {
+        throw std::logic_error("vocabulary is read only");
+    }
+    if ((m_size + 1) * 2 > m_slotsStorage.size()) {
+        rehash(std::max(minSlots, m_slotsStorage.size() * 2));
+    }
+
+    auto h = hash(_word);
+    for (auto i = h & m_mask;; i = (i + 1) & m_mask) {
+        auto &slot = m_slotsStorage[i];
+        if (slot.word == npos) {
+            slot.hash = h;
+            slot.word = static_cast<uint32_t>(m_offsetsStorage.size());
+            slot.value = _value;
+            m_offsetsStorage.emplace_back(m_arenaStorage.size());
+            m_lengthsStorage.emplace_back(static_cast<uint32_t>(_word.size()));
+            m_arenaStorage.append(_word);
+            bindStorage();
+            return;
+        }
+        if ((slot.hash == h) && (word(slot.word) == _word)) {
+            return;
+        }
+    }
+}
+
+uint32_t vocabulary_t::find(std::string_view _word) const noexcept {
+    if (m_size == 0) {
+        return npos;
+    }
+
+    auto h = hash(_word);
+    for (auto i = h & m_mask;; i = (i + 1) & m_mask) {
+        const auto &slot = m_slots[i];
+        if (slot.word == npos) {
+            return npos;
+        }
+        if ((slot.hash == h) && (word(slot.word) == _word)) {
+            return slot.value;
+        }
+    }
+}
+
+void vocabulary_t::shrink() {
+    if (m_attached) {
+        return;
+    }
+    m_arenaStorage.shrink_to_fit();
+    m_offsetsStorage.shrink_to_fit();
+    m_lengthsStorage.shrink_to_fit();
+    bindStorage();
+}
+
+std::size_t vocabulary_t::serializedSize() const noexcept {
+    return sections(serializedHeader()).size;
+}
+
+void vocabulary_t::serialize(uint8_t *_data) const noexcept {
+    auto header = serializedHeader();
+    auto s = sections(header);
+
+    std::memset(_data, 0, s.size);
+    std::memcpy(_data, &header, sizeof(header));
+    if (m_size == 0) {
+        return;
+    }
+    std::memcpy(_data + s.slots, m_slots, header.slots * sizeof(slot_t));
+    std::memcpy(_data + s.offsets, m_offsets, header.words * sizeof(uint64_t));
+    std::memcpy(_data + s.lengths, m_lengths, header.words * sizeof(uint32_t));
+    std::memcpy(_data + s.arena, m_arena, header.arenaSize);
+}
+
+void vocabulary_t::attach(const uint8_t *_data, std::size_t _size, std::size_t _values) {
+    serialized_t header;
+    if (_size < sizeof(header)) {
+        throw std::runtime_error("wrong vocabulary size");
+    }
+    std::memcpy(&header, _data, sizeof(header));
+    // section sizes are bounded first, so their sum does not overflow
+    if ((header.slots > _size / sizeof(slot_t)) || (header.words > _size / sizeof(uint64_t))
+        || (header.arenaSize > _size)) {
+        throw std::runtime_error("wrong vocabulary format");
+    }
+    auto s = sections(header);
+    if ((s.size > _size) || ((header.slots & (header.slots - 1)) != 0) || (header.words * 2 > header.slots)
+        || (header.words >= npos)) {
+        throw std::runtime_error("wrong vocabulary format");
+    }
+
+    // words are within the arena, slots refer existing words and values; probes stop at an empty slot, so at most
+    // words slots are used
+    auto slots = reinterpret_cast<const slot_t *>(_data + s.slots);
+    auto offsets = reinterpret_cast<const uint64_t *>(_data + s.offsets);
+    auto lengths = reinterpret_cast<const uint32_t *>(_data + s.lengths);
+    for (std::size_t i = 0; i < header.words; ++i) {
+        if ((offsets[i] > header.arenaSize) || (lengths[i] > header.arenaSize - offsets[i])) {
+            throw std::runtime_error("wrong vocabulary format");
+        }
+    }
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < header.slots; ++i) {
+        if (slots[i].word == npos) {
+            continue;
+        }
+        if ((slots[i].word >= header.words) || (slots[i].value >= _values)) {
+            throw std::runtime_error("wrong vocabulary format");
+        }
+        ++used;
+    }
+    if (used > header.words) {
+        throw std::runtime_error("wrong vocabulary format");
+    }
+
+    m_slotsStorage = {};
+    m_arenaStorage = {};
+    m_offsetsStorage = {};
+    m_lengthsStorage = {};
+    m_slots = slots;
+    m_mask = (header.slots > 0)?header.slots - 1:0;
+    m_offsets = offsets;
+    m_lengths = lengths;
+    m_arena = reinterpret_cast<const char *>(_data + s.arena);
+    m_size = header.words;
+    m_attached = true;
+}
+
+vocabulary_t::serialized_t vocabulary_t::serializedHeader() const noexcept {
+    serialized_t ret;
+    if (m_size > 0) {
+        ret.slots = m_mask + 1;
+        ret.words = m_size;
+        // words are appended to the arena
+        ret.arenaSize = m_offsets[m_size - 1] + m_lengths[m_size - 1];
+    }
+    return ret;
+}
+
+vocabulary_t::sections_t vocabulary_t::sections(const serialized_t &_header) noexcept {
+    sections_t ret;
+    ret.slots = sizeof(serialized_t);
+    ret.offsets = ret.slots + _header.slots * sizeof(slot_t);
+    ret.lengths = ret.offsets + _header.words * sizeof(uint64_t);
+    ret.arena = align8(ret.lengths + _header.words * sizeof(uint32_t));
+    ret.size = align8(ret.arena + _header.arenaSize);
+    return ret;
+}
+
+void vocabulary_t::rehash(std::size_t _slots) {
+    std::vector<slot_t> slots(_slots);
+    auto mask = _slots - 1;
+    for (const auto &slot:m_slotsStorage) {
+        if (slot.word == npos) {
+            continue;
+        }
+        auto i = slot.hash & mask;
+        while (slots[i].word != npos) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+    m_slotsStorage.swap(slots);
+    m_mask = mask;
+    bindStorage();
+}
+
+void vocabulary_t::bindStorage() noexcept {
+    m_slots = m_slotsStorage.data();
+    m_arena = m_arenaStorage.data();
+    m_offsets = m_offsetsStorage.data();
+    m_lengths = m_lengthsStorage.data();
+    m_size = m_offsetsStorage.size();
+}
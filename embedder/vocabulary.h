@@ -0,0 +1,96 @@
+/**
+ * @file embedder/vocabulary.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_VOCABULARY_H
+#define TGNEWS_VOCABULARY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Word to value map built once at model load. Words are stored in a single arena and looked up by string_view,
+// so tokens are neither copied nor allocated. Open addressing with linear probing, slots keep the full hash,
+// so keys are compared only on hash matches.
+// The table may be serialized and then used in place, e.g. from a read-only memory mapped file.
+class vocabulary_t final {
+public:
+    static const uint32_t npos = UINT32_MAX;
+
+    vocabulary_t() = default;
+
+    vocabulary_t(const vocabulary_t &) = delete;
+    void operator=(const vocabulary_t &) = delete;
+
+    // the first value of a word is kept, attached vocabularies are read only
+    void insert(std::string_view _word, uint32_t _value);
+    // returns npos if the word is not found
+    [[nodiscard]] uint32_t find(std::string_view _word) const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept {return m_size;}
+    // _idx-th inserted word, _idx = [0, size())
+    [[nodiscard]] std::string_view word(uint32_t _idx) const noexcept {
+        return std::string_view(m_arena + m_offsets[_idx], m_lengths[_idx]);
+    }
+    // releases the build time spare capacity
+    void shrink();
+
+    // serialized table size, a multiple of 8 bytes
+    [[nodiscard]] std::size_t serializedSize() const noexcept;
+    // writes serializedSize() bytes to _data, 8 bytes aligned
+    void serialize(uint8_t *_data) const noexcept;
+    // uses the serialized table in place, _data (8 bytes aligned) must outlive the vocabulary;
+    // the table is validated, values must be less than _values
+    void attach(const uint8_t *_data, std::size_t _size, std::size_t _values);
+
+    static uint64_t hash(std::string_view _word) noexcept;
+
+private:
+    struct slot_t {
+        uint64_t hash = 0;
+        // index of the word, npos - empty slot
+        uint32_t word = npos;
+        uint32_t value = 0;
+    };
+
+    // serialized table: header, slots, offsets, lengths, arena
+    struct serialized_t {
+        uint64_t slots = 0;
+        uint64_t words = 0;
+        uint64_t arenaSize = 0;
+    };
+    // section positions of the serialized table
+    struct sections_t {
+        std::size_t slots = 0;
+        std::size_t offsets = 0;
+        std::size_t lengths = 0;
+        std::size_t arena = 0;
+        std::size_t size = 0;
+    };
+
+    // build time storage, empty if attached
+    std::vector<slot_t> m_slotsStorage;
+    std::string m_arenaStorage;
+    // word positions in the arena
+    std::vector<uint64_t> m_offsetsStorage;
+    std::vector<uint32_t> m_lengthsStorage;
+
+    // the table, points either to the storage or to the attached data
+    const slot_t *m_slots = nullptr;
+    std::size_t m_mask = 0;
+    const char *m_arena = nullptr;
+    const uint64_t *m_offsets = nullptr;
+    const uint32_t *m_lengths = nullptr;
+    std::size_t m_size = 0;
+    bool m_attached = false;
+
+    [[nodiscard]] serialized_t serializedHeader() const noexcept;
+    static sections_t sections(const serialized_t &_header) noexcept;
+    void rehash(std::size_t _slots);
+    void bindStorage() noexcept;
+};
+
+#endif //TGNEWS_VOCABULARY_H
@@ -0,0 +1,112 @@
+/**
+ * @file inference/heads.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include "heads.h"
+
+heads_t::heads_t(const linearLayer_t &_newsLayer, const linearLayer_t &_categoryLayer,
+                 const linearLayer_t &_weightLayer,
+                 newsReference_t _newsReference, categoryReference_t _categoryReference):
+        m_newsReference(std::move(_newsReference)), m_categoryReference(std::move(_categoryReference)) {
+    if ((_newsLayer.outputs() != 1)
+        || (!_categoryLayer.empty() && (_categoryLayer.outputs() != categories))
+        || (!_weightLayer.empty() && (_weightLayer.outputs() != 1))) {
+        throw std::runtime_error("heads_t: wrong number of model outputs");
+    }
+
+    m_layer.append(_newsLayer);
+    if (!_categoryLayer.empty()) {
+        m_layer.append(_categoryLayer);
+        m_category = true;
+    }
+    if (!_weightLayer.empty()) {
+        m_weightOutput = m_layer.outputs();
+        m_layer.append(_weightLayer);
+    }
+}
+
+void heads_t::operator()(const float *_vector, prediction_t &_prediction) const noexcept {
+    float y[maxOutputs];
+    m_layer(_vector, y);
+
+    _prediction = prediction_t();
+    _prediction.news = (y[newsOutput] > 0.0f);
+    bool newsTie = m_newsReference && (std::fabs(y[newsOutput]) < tieMargin);
+    bool categoryTie = false;
+    if (m_category) {
+        std::size_t category = 0;
+        for (std::size_t i = 1; i < categories; ++i) {
+            if (y[categoryOutput + i] > y[categoryOutput + category]) {
+                category = i;
+            }
+        }
+        _prediction.category = static_cast<categories_t>(category);
+        for (std::size_t i = 0; m_categoryReference && (i < categories) && !categoryTie; ++i) {
+            categoryTie = (i != category) && (y[categoryOutput + category] - y[categoryOutput + i] < tieMargin);
+        }
+    }
+
+    // the kernel results are kept if a reference fails
+    try {
+        if (newsTie) {
+            _prediction.news = m_newsReference(_vector);
+            m_referenced.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (categoryTie) {
+            _prediction.category = m_categoryReference(_vector);
+            m_referenced.fetch_add(1, std::memory_order_relaxed);
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+    }
+    if (m_weightOutput > 0) {
+        _prediction.weight = y[m_weightOutput];
+    }
+}
+
+void heads_t::operator()(const matrix_t &_vectors,
+                         std::size_t _startFrom, std::size_t _stopAt,
+                         std::vector<prediction_t> &_result) const noexcept {
+    if (_startFrom >= _stopAt) {
+        return;
+    }
+
+    try {
+        _result.resize(_stopAt - _startFrom);
+        for (auto i = _startFrom; i < _stopAt; ++i) {
+            (*this)(_vectors.row(i), _result[i - _startFrom]);
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+    }
+}
+
+void heads_t::operator()(const matrix_t &_vectors,
+                         const std::vector<uint32_t> &_rows,
+                         std::size_t _startFrom, std::size_t _stopAt,
+                         std::vector<prediction_t> &_result) const noexcept {
+    if (_startFrom >= _stopAt) {
+        return;
+    }
+
+    try {
+        _result.resize(_stopAt - _startFrom);
+        for (auto i = _startFrom; i < _stopAt; ++i) {
+            (*this)(_vectors.row(_rows[i]), _result[i - _startFrom]);
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+    }
+}
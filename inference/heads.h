@@ -0,0 +1,80 @@
+/**
+ * @file inference/heads.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_HEADS_H
+#define TGNEWS_HEADS_H
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "types.h"
+#include "linearLayer.h"
+
+// News, category and weight heads of a language model fused into one linear layer of 9 outputs, a document vector
+// is read once for all of them. The news decision and the category argmax are taken in place, the same way as by the
+// dlib loss layers: news if the logit is positive, the first maximal category logit wins.
+// The SIMD kernels sum in another order than dlib, so logits within tieMargin of the decision boundary (news logit
+// near zero, two top category logits near each other) are decided by the dlib networks themselves, if given.
+// Category and weight heads are optional, the news detection alone does not need them.
+// Weights are immutable, one instance is shared by any number of threads.
+class heads_t final {
+public:
+    struct prediction_t {
+        bool news = false;
+        categories_t category = categories_t::OTHER;
+        float weight = 0.0f;
+    };
+
+    // decisions of the trained networks, called concurrently
+    using newsReference_t = std::function<bool(const float *_vector)>;
+    using categoryReference_t = std::function<categories_t(const float *_vector)>;
+
+    // margin of the logits decided by the references, the summation order changes a logit by ~1e-6
+    static constexpr float tieMargin = 1e-3f;
+
+    // empty _categoryLayer or _weightLayer are not fused, their predictions are OTHER and 0
+    heads_t(const linearLayer_t &_newsLayer, const linearLayer_t &_categoryLayer, const linearLayer_t &_weightLayer,
+            newsReference_t _newsReference = nullptr, categoryReference_t _categoryReference = nullptr);
+    ~heads_t() = default;
+
+    heads_t(const heads_t &) = delete;
+    void operator=(const heads_t &) = delete;
+
+    void operator()(const float *_vector, prediction_t &_prediction) const noexcept;
+    // predicts rows [_startFrom, _stopAt) of _vectors
+    void operator()(const matrix_t &_vectors,
+                    std::size_t _startFrom, std::size_t _stopAt,
+                    std::vector<prediction_t> &_result) const noexcept;
+    // predicts rows _rows[i] of _vectors, i = [_startFrom, _stopAt)
+    void operator()(const matrix_t &_vectors,
+                    const std::vector<uint32_t> &_rows,
+                    std::size_t _startFrom, std::size_t _stopAt,
+                    std::vector<prediction_t> &_result) const noexcept;
+
+    [[nodiscard]] std::size_t inputs() const noexcept {return m_layer.inputs();}
+    [[nodiscard]] bool hasCategory() const noexcept {return m_category;}
+    // predictions decided by the references
+    [[nodiscard]] std::size_t referenced() const noexcept {return m_referenced.load(std::memory_order_relaxed);}
+
+private:
+    static constexpr std::size_t newsOutput = 0;
+    static constexpr std::size_t categoryOutput = 1;
+    static constexpr std::size_t categories = 7;
+    static constexpr std::size_t maxOutputs = categoryOutput + categories + 1;
+
+    linearLayer_t m_layer;
+    bool m_category = false;
+    // 0 - no weight head
+    std::size_t m_weightOutput = 0;
+    newsReference_t m_newsReference;
+    categoryReference_t m_categoryReference;
+    mutable std::atomic<std::size_t> m_referenced{0};
+};
+
+#endif //TGNEWS_HEADS_H
@@ -0,0 +1,175 @@
+/**
+ * @file inference/headsBench.cpp
+ * @brief fused heads throughput and predictions against the dlib networks
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif
+#include <dlib/dnn.h>
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+#include "vecMath/vecMath.h"
+#include "heads.h"
+
+// the same networks as loaded by newsDetector_t, categorizer_t and ranker_t
+using binaryLabelNet_t = dlib::loss_binary_log<dlib::fc<1, dlib::input<dlib::matrix<float>>>>;
+using multiLabelNet_t = dlib::loss_multiclass_log<dlib::fc<7, dlib::input<dlib::matrix<float>>>>;
+using weightNet_t = dlib::loss_mean_squared<dlib::fc<1, dlib::input<dlib::matrix<float>>>>;
+
+// a single sample as the networks take it
+static std::vector<dlib::matrix<float>> sample(const float *_vector, std::size_t _size) {
+    std::vector<dlib::matrix<float>> ret(1);
+    ret[0].set_size(1, static_cast<long>(_size));
+    for (std::size_t j = 0; j < _size; ++j) {
+        ret[0](j) = _vector[j];
+    }
+
+    return ret;
+}
+
+// runs _pass over the batch until _seconds elapsed, returns vectors/s
+template<typename pass_t>
+static double measure(const pass_t &_pass, std::size_t _batch, double _seconds) {
+    std::size_t vectors = 0;
+    auto started = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < _seconds) {
+        _pass();
+        vectors += _batch;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    return static_cast<double>(vectors) / elapsed;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0] << " news_model category_model weight_model [batch]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::size_t batch = (argc > 4)?std::strtoul(argv[4], nullptr, 10):4096;
+
+    try {
+        binaryLabelNet_t newsNet;
+        dlib::deserialize(argv[1]) >> newsNet;
+        multiLabelNet_t categoryNet;
+        dlib::deserialize(argv[2]) >> categoryNet;
+        weightNet_t weightNet;
+        dlib::deserialize(argv[3]) >> weightNet;
+
+        auto newsLayer = linearLayer_t::fc(dlib::layer<1>(newsNet).layer_details());
+        auto categoryLayer = linearLayer_t::fc(dlib::layer<1>(categoryNet).layer_details());
+        auto weightLayer = linearLayer_t::fc(dlib::layer<1>(weightNet).layer_details());
+        auto size = newsLayer.inputs();
+        // ties are decided by the networks, as newsDetector_t::reference() and categorizer_t::reference() do
+        heads_t heads(newsLayer, categoryLayer, weightLayer,
+                      [&newsNet, size](const float *_vector) {return newsNet(sample(_vector, size))[0] > 0.0f;},
+                      [&categoryNet, size](const float *_vector) {
+                          return static_cast<categories_t>(categoryNet(sample(_vector, size))[0]);
+                      });
+        heads_t kernelHeads(newsLayer, categoryLayer, weightLayer);
+
+        // unit length random vectors, as documents are embedded
+        matrix_t vectors(batch, size);
+        std::mt19937 generator(1);
+        std::normal_distribution<float> distribution;
+        for (std::size_t i = 0; i < batch; ++i) {
+            auto row = vectors.row(i);
+            for (std::size_t j = 0; j < size; ++j) {
+                row[j] = distribution(generator);
+            }
+            vecMath_t::scale(row, size, 1.0f / std::sqrt(vecMath_t::sumOfSquares(row, size)));
+        }
+
+        // dlib: samples are copied to dlib matrices, every network is a separate forward pass
+        std::vector<float> newsLogits;
+        std::vector<unsigned long> categories;
+        std::vector<float> weights;
+        auto dlibRate = measure([&] {
+            std::vector<dlib::matrix<float>> samples(batch);
+            for (std::size_t i = 0; i < batch; ++i) {
+                samples[i].set_size(1, static_cast<long>(size));
+                for (std::size_t j = 0; j < size; ++j) {
+                    samples[i](j) = vectors.row(i)[j];
+                }
+            }
+            newsLogits = newsNet(samples);
+            categories = categoryNet(samples);
+            weights = weightNet(samples);
+        }, batch, 2.0);
+
+        // extracted layers evaluated one by one
+        float y[9];
+        volatile float sink = 0.0f;
+        auto layersRate = measure([&] {
+            for (std::size_t i = 0; i < batch; ++i) {
+                newsLayer(vectors.row(i), y);
+                categoryLayer(vectors.row(i), y + 1);
+                weightLayer(vectors.row(i), y + 8);
+                sink = sink + y[0] + y[1] + y[8];
+            }
+        }, batch, 2.0);
+
+        std::vector<heads_t::prediction_t> predictions;
+        auto headsRate = measure([&] {
+            heads(vectors, 0, batch, predictions);
+        }, batch, 2.0);
+
+        // rows of a single batch decided by the networks
+        auto referenced = heads.referenced();
+        heads(vectors, 0, batch, predictions);
+        referenced = heads.referenced() - referenced;
+
+        // the kernels alone may differ from dlib near the decision boundaries
+        std::vector<heads_t::prediction_t> kernelPredictions;
+        kernelHeads(vectors, 0, batch, kernelPredictions);
+        std::size_t kernelMismatches = 0;
+        std::size_t newsMismatches = 0;
+        std::size_t categoryMismatches = 0;
+        float weightError = 0.0f;
+        for (std::size_t i = 0; i < batch; ++i) {
+            kernelMismatches += (((newsLogits[i] > 0.0f) != kernelPredictions[i].news)
+                                 || (static_cast<categories_t>(categories[i]) != kernelPredictions[i].category))?1:0;
+            newsMismatches += ((newsLogits[i] > 0.0f) != predictions[i].news)?1:0;
+            categoryMismatches += (static_cast<categories_t>(categories[i]) != predictions[i].category)?1:0;
+            weightError = std::max(weightError, std::fabs(weights[i] - predictions[i].weight));
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "ISA " << vecMath_t::name(vecMath_t::isa()) << ", " << size << " inputs, batch " << batch
+                  << std::endl
+                  << "dlib   " << std::setw(10) << dlibRate / 1e6 << " Mvectors/s" << std::endl
+                  << "layers " << std::setw(10) << layersRate / 1e6 << " Mvectors/s" << std::endl
+                  << "fused  " << std::setw(10) << headsRate / 1e6 << " Mvectors/s" << std::endl
+                  << std::scientific
+                  << "news mismatches " << newsMismatches << ", category mismatches " << categoryMismatches
+                  << ", max weight error " << weightError << std::endl
+                  << "decided by dlib " << referenced << ", kernel only mismatches " << kernelMismatches
+                  << std::endl;
+
+        if ((newsMismatches != 0) || (categoryMismatches != 0)) {
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
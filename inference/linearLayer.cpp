@@ -0,0 +1,40 @@
+/**
+ * @file inference/linearLayer.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include "vecMath/vecMath.h"
+#include "linearLayer.h"
+
+linearLayer_t::linearLayer_t(std::size_t _inputs, std::size_t _outputs, const float *_params):
+        m_weights(_outputs, _inputs), m_biases(_params + _inputs * _outputs, _params + (_inputs + 1) * _outputs) {
+    for (std::size_t o = 0; o < _outputs; ++o) {
+        auto row = m_weights.row(o);
+        for (std::size_t i = 0; i < _inputs; ++i) {
+            row[i] = _params[i * _outputs + o];
+        }
+    }
+}
+
+void linearLayer_t::operator()(const float *_x, float *_y) const noexcept {
+    vecMath_t::gemv(m_weights.row(0), m_weights.stride(), m_weights.rows(), _x, m_weights.cols(), _y);
+    for (std::size_t o = 0; o < m_biases.size(); ++o) {
+        _y[o] += m_biases[o];
+    }
+}
+
+void linearLayer_t::append(const linearLayer_t &_layer) {
+    if (empty()) {
+        m_weights.resize(0, _layer.inputs());
+    } else if (_layer.inputs() != inputs()) {
+        throw std::runtime_error("linearLayer_t: layer inputs mismatch");
+    }
+
+    m_weights.reserve(outputs() + _layer.outputs());
+    for (std::size_t o = 0; o < _layer.outputs(); ++o) {
+        m_weights.append(_layer.m_weights.row(o));
+    }
+    m_biases.insert(m_biases.end(), _layer.m_biases.begin(), _layer.m_biases.end());
+}
@@ -0,0 +1,61 @@
+/**
+ * @file inference/linearLayer.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_LINEARLAYER_H
+#define TGNEWS_LINEARLAYER_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "vecMath/matrix.h"
+
+// Fully connected layer y = x * W + b, weights are extracted from a trained dlib fc layer at load time and stored
+// transposed, one aligned row by output, so all outputs are evaluated by one vecMath_t::gemv pass over x.
+// Weights are immutable after construction, evaluation is thread safe and does not allocate.
+class linearLayer_t final {
+public:
+    linearLayer_t() noexcept = default;
+    // _params - dlib fc layer parameters with bias: W[i][o] = _params[i * _outputs + o],
+    // b[o] = _params[_inputs * _outputs + o]
+    linearLayer_t(std::size_t _inputs, std::size_t _outputs, const float *_params);
+    ~linearLayer_t() = default;
+
+    linearLayer_t(const linearLayer_t &) = delete;
+    void operator=(const linearLayer_t &) = delete;
+    linearLayer_t(linearLayer_t &&) noexcept = default;
+    linearLayer_t &operator=(linearLayer_t &&) noexcept = default;
+
+    // _fc - layer details of a dlib fc layer with bias, e.g. dlib::layer<1>(net).layer_details()
+    template<typename fc_t>
+    [[nodiscard]] static linearLayer_t fc(const fc_t &_fc) {
+        const auto &params = _fc.get_layer_params();
+        auto outputs = static_cast<std::size_t>(_fc.get_num_outputs());
+        auto size = static_cast<std::size_t>(params.size());
+        if ((outputs == 0) || (size % outputs != 0) || (size / outputs < 2)) {
+            throw std::runtime_error("linearLayer_t: wrong fc layer parameters");
+        }
+        return linearLayer_t(size / outputs - 1, outputs, params.host());
+    }
+
+    // _y[o] = dot(_x, W[][o]) + b[o], o = [0, outputs())
+    void operator()(const float *_x, float *_y) const noexcept;
+
+    // outputs of _layer follow the outputs of this layer, inputs must be equal
+    void append(const linearLayer_t &_layer);
+
+    [[nodiscard]] std::size_t inputs() const noexcept {return m_weights.cols();}
+    [[nodiscard]] std::size_t outputs() const noexcept {return m_weights.rows();}
+    [[nodiscard]] bool empty() const noexcept {return m_weights.empty();}
+
+private:
+    // row by output
+    matrix_t m_weights;
+    std::vector<float> m_biases;
+};
+
+#endif //TGNEWS_LINEARLAYER_H
@@ -12,8 +12,11 @@
 
 #include <chrono>
 
+#include <sys/resource.h>
+
 #include "config.h"
 #include "types.h"
+#include "dataLoader/gumboArena.h"
 #include "cli/cli.h"
 #include "httpServer/httpServer.h"
 #include "repository/repository.h"
@@ -30,7 +33,8 @@ static void usage(const char *_name) {
                << "    threads" << std::endl
                << "      Group similar news into threads from [param] folder" << std::endl
                << "    server <port>" << std::endl
-               << "      Run as an HTTP server on port [param]" << std::endl;
+               << "      Run as an HTTP server on port [param]" << std::endl
+               << "  Input [param] may also be a .tar, .tar.gz, .tgz, .bundle or .bundle.gz file" << std::endl;
 }
 
 int main(int argc, char *argv[]) {
@@ -88,6 +92,21 @@ int main(int argc, char *argv[]) {
                 {categories_t::OTHER, "other"},
         };
 
+        pipelineSettings_t pipelineSettings;
+        pipelineSettings.enabled = g_pipelineMode;
+        pipelineSettings.queueSize = g_pipelineQueueSize;
+        pipelineSettings.batchSize = g_pipelineBatchSize;
+        pipelineSettings.parsers = g_pipelineParsers;
+        pipelineSettings.langDetectors = g_pipelineLangDetectors;
+        pipelineSettings.embedders = g_pipelineEmbedders;
+        pipelineSettings.newsDetectors = g_pipelineNewsDetectors;
+        pipelineSettings.categorizers = g_pipelineCategorizers;
+        pipelineSettings.memoryBudget = g_pipelineMemoryBudget;
+
+        embedderSettings_t embedderSettings;
+        embedderSettings.decodedWords = g_faissDecodedWords;
+        embedderSettings.decodedFp16 = g_faissDecodedFp16;
+
         auto threads = std::thread::hardware_concurrency();
         if (threads < g_threads) {
             threads = g_threads;
@@ -99,13 +118,15 @@ int main(int argc, char *argv[]) {
                 repository = std::make_unique<repository_t>(threads,
                                                             langCodes,
                                                             w2vModels,
+                                                            embedderSettings,
                                                             newsDetectionModels,
                                                             categoryDetectionModels,
                                                             weightDetectionModels,
                                                             categoryNames,
                                                             similarityThreshold,
                                                             g_sqliteFile,
-                                                            indexFiles);
+                                                            indexFiles,
+                                                            g_htmlParser);
             } catch (const std::exception &_e) {
                 std::cerr << _e.what() << std::endl;
                 return EXIT_FAILURE;
@@ -128,19 +149,37 @@ int main(int argc, char *argv[]) {
             std::cout << "server is running on " << argv[2] << " port" << std::endl;
             httpServer->dispatch(repository_t::onPut, repository_t::onDelete, repository_t::onGet, repository.get());
             std::cout << "server is shutting down" << std::endl;
+            std::cout << "HTML parser arena high-water mark: " << gumboArena_t::peakHighWaterMark()
+                      << " bytes, trees over " << gumboArena_t::maxTreeSize << " bytes: " << gumboArena_t::overflows()
+                      << std::endl;
         } else {
             const auto processingStarted = std::chrono::high_resolution_clock::now();
             cli_t cli(langCodes,
                       w2vModels,
+                      embedderSettings,
                       newsDetectionModels,
                       categoryDetectionModels,
                       categoryNames,
-                      similarityThreshold);
+                      similarityThreshold,
+                      pipelineSettings,
+                      g_htmlParser,
+                      g_ioUring,
+                      g_docCacheFile);
             cli(threads, cmd, argv + 2);
             auto processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
                     std::chrono::high_resolution_clock::now() - processingStarted
             ).count();
             std::cerr << std::endl << "Processed in " << processingTime << " ms" << std::endl;
+
+            rusage usage {};
+            if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+                auto peakRss = static_cast<std::size_t>(usage.ru_maxrss); // bytes
+#else
+                auto peakRss = static_cast<std::size_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+                std::cerr << "Peak RSS: " << peakRss << " bytes" << std::endl;
+            }
         }
 
         return EXIT_SUCCESS;
@@ -6,86 +6,175 @@
 */
 
 #include <thread>
+#include <iostream>
 
+#include "scheduler/chunkScheduler.h"
+#include "dataLoader/docCache.h"
 #include "embedder/embedder.h"
 #include "newsDetector/newsDetector.h"
+#include "categorizer/categorizer.h"
+#include "inference/heads.h"
 #include "newsCluster.h"
 
 newsCluster_t::newsCluster_t(uint8_t _threads,
                              const std::unordered_map<std::string, std::string> &_w2vLangModelFileNames,
+                             const embedderSettings_t &_embedderSettings,
                              const std::unordered_map<std::string, std::string> &_newsLangModelFileNames,
-                             const langDocSet_t &_langDocSet) {
+                             const std::unordered_map<std::string, std::string> &_categoryLangModelFileNames,
+                             docTable_t &_docTable,
+                             const langDocSet_t &_langDocSet,
+                             docCache_t *_docCache): m_docCache(_docCache) {
+    // vectors of all languages are stored to one matrix of the table, rows are allocated at once
+    std::size_t vectorSize = 0;
+    std::size_t documents = 0;
     for (const auto &wm:_w2vLangModelFileNames) {
-        m_embedder.emplace(wm.first, std::make_unique<embedder_t>(wm.second));
+        auto &embedder = m_embedder.emplace(wm.first,
+                                            std::make_unique<embedder_t>(wm.second, _embedderSettings)).first->second;
+        if ((vectorSize != 0) && (vectorSize != embedder->vectorSize())) {
+            throw std::runtime_error("vector size of w2v model differs for language \"" + wm.first + "\"");
+        }
+        vectorSize = embedder->vectorSize();
 
-        m_langVecSet.emplace(wm.first, vecSet_t());
+        auto langDocs = _langDocSet.find(wm.first);
+        if (langDocs == _langDocSet.end()) {
+            throw std::runtime_error("w2v model file is not defined for language \"" + wm.first + "\"");
+        }
+        documents += langDocs->second.size();
+    }
+    _docTable.vectors.resize(0, vectorSize);
+    _docTable.vectors.reserve(documents);
+    if (!_categoryLangModelFileNames.empty()) {
+        m_categories.resize(_docTable.size(), categories_t::OTHER);
+    }
+
+    for (const auto &wm:_w2vLangModelFileNames) {
+        m_langVecSet.emplace(wm.first, docIds_t());
 
         auto newsLangModelItr = _newsLangModelFileNames.find(wm.first);
         if (newsLangModelItr == _newsLangModelFileNames.end()) {
             throw std::runtime_error("news detection model file is not defined for language \"" + wm.first + "\"");
         }
-
-        auto langDocs = _langDocSet.find(wm.first);
-        if (langDocs == _langDocSet.end()) {
-            throw std::runtime_error("w2v model file is not defined for language \"" + wm.first + "\"");
+        // models are loaded once and shared by the workers
+        std::unique_ptr<heads_t> heads;
+        {
+            newsDetector_t newsDetector(newsLangModelItr->second);
+            if (_categoryLangModelFileNames.empty()) {
+                heads = std::make_unique<heads_t>(newsDetector.layer(), linearLayer_t(), linearLayer_t(),
+                                                  newsDetector.reference());
+            } else {
+                auto categoryLangModelItr = _categoryLangModelFileNames.find(wm.first);
+                if (categoryLangModelItr == _categoryLangModelFileNames.end()) {
+                    throw std::runtime_error("category detection model file is not defined for language \""
+                                             + wm.first + "\"");
+                }
+                categorizer_t categorizer(categoryLangModelItr->second);
+                heads = std::make_unique<heads_t>(newsDetector.layer(), categorizer.layer(), linearLayer_t(),
+                                                  newsDetector.reference(), categorizer.reference());
+            }
         }
+        if (heads->inputs() != vectorSize) {
+            throw std::runtime_error("news detection model does not match w2v model for language \""
+                                     + wm.first + "\"");
+        }
+
+        const auto &langDocs = _langDocSet.at(wm.first);
 
-        std::vector<std::string> fileNames;
-        std::vector<document_t> documents;
-        for (const auto &d:langDocs->second) {
-            fileNames.emplace_back(d.first);
-            documents.emplace_back(d.second);
+        // documents are accessed in the table by ids, vectors by rows, documents with cached vectors are not embedded
+        docIds_t ids;
+        std::vector<uint32_t> rows;
+        docIds_t cachedIds;
+        std::vector<uint32_t> cachedRows;
+        auto row = static_cast<uint32_t>(_docTable.vectors.rows());
+        _docTable.vectors.resize(row + langDocs.size(), vectorSize);
+        for (auto id:langDocs) {
+            _docTable.vectorRows[id] = row;
+            if ((m_docCache != nullptr)
+                && m_docCache->lookupVector(_docTable.fileNames[id], _docTable.vectors.row(row), vectorSize)) {
+                cachedIds.emplace_back(id);
+                cachedRows.emplace_back(row++);
+                continue;
+            }
+            ids.emplace_back(id);
+            rows.emplace_back(row++);
         }
+        auto embed = ids.size();
+        ids.insert(ids.end(), cachedIds.begin(), cachedIds.end());
+        rows.insert(rows.end(), cachedRows.begin(), cachedRows.end());
 
         std::vector<std::thread> thrPool;
-        uint8_t workers = documents.empty()?
-                          0:
-                          ((documents.size() < _threads)?
-                           documents.size():
-                           _threads);
+        // DNN inference is more efficient on batches, so documents are not dispatched one by one
+        chunkScheduler_t scheduler(ids.size(), _threads, 64);
+        uint8_t workers = ids.empty()?0:scheduler.workers();
         for (int i = 0; i < workers; ++i) {
-            thrPool.emplace_back(std::thread(&newsCluster_t::worker, this, i, workers,
+            thrPool.emplace_back(std::thread(&newsCluster_t::worker, this, std::ref(scheduler),
                                              std::cref(wm.first),
-                                             std::cref(newsLangModelItr->second),
-                                             std::cref(fileNames),
-                                             std::cref(documents)));
+                                             std::cref(*heads),
+                                             std::ref(_docTable),
+                                             std::cref(ids),
+                                             std::cref(rows),
+                                             embed));
         }
         for (auto &i:thrPool) {
             i.join();
         }
     }
+
+    // rows of documents which are not news are released
+    _docTable.shrinkVectors();
 }
 
 newsCluster_t::~newsCluster_t() = default;
 
-void newsCluster_t::worker(uint8_t _thrID,
-                           uint8_t _threads,
+void newsCluster_t::worker(chunkScheduler_t &_scheduler,
                            const std::string &_langCode,
-                           const std::string &_newsLangModelFileName,
-                           const std::vector<std::string> &_fileNames,
-                           const std::vector<document_t> &_documents) noexcept {
-    std::size_t textsPerThread = _documents.size() / _threads;
-    std::size_t startFrom = _thrID * textsPerThread;
-    std::size_t stopAt = ((_thrID == _threads - 1)?_documents.size():startFrom + textsPerThread);
-
+                           const heads_t &_heads,
+                           docTable_t &_docTable,
+                           const docIds_t &_ids,
+                           const std::vector<uint32_t> &_rows,
+                           std::size_t _embed) noexcept {
     try {
-        std::vector<std::vector<float>> vectors;
         auto emi = m_embedder.find(_langCode);
         if (emi == m_embedder.end()) {
             std::cerr << "no embedding model for language " << _langCode << std::endl;
             return;
         }
-        (*emi->second)(_documents, startFrom, stopAt, vectors);
 
-        std::vector<bool> newsFlags;
-        newsDetector_t newsDetector(_newsLangModelFileName);
-        newsDetector(vectors, 0, vectors.size(), newsFlags);
+        std::size_t startFrom = 0;
+        std::size_t stopAt = 0;
+        while (_scheduler.next(startFrom, stopAt)) {
+            // every document is processed by one worker only, so table rows are written without locking
+            auto embedStop = (stopAt < _embed)?stopAt:_embed;
+            if (startFrom < embedStop) {
+                (*emi->second)(_docTable.documents, _ids, startFrom, embedStop, _docTable.vectors, _rows);
+                for (auto i = startFrom; i < embedStop; ++i) {
+                    if (m_docCache != nullptr) {
+                        m_docCache->insertVector(_docTable.fileNames[_ids[i]],
+                                                 _docTable.vectors.row(_rows[i]), _docTable.vectors.cols());
+                    }
+                    // texts are not needed by the output
+                    std::string().swap(_docTable.documents[_ids[i]].text);
+                }
+            }
 
-        std::unique_lock<std::mutex> lck(m_mtx);
-        for (std::size_t i = 0; i < vectors.size(); ++i) {
-            if (newsFlags[i]) {
-                m_langVecSet.at(_langCode).emplace(_fileNames[i + startFrom], vectors[i]);
+            std::vector<heads_t::prediction_t> predictions;
+            _heads(_docTable.vectors, _rows, startFrom, stopAt, predictions);
+
+            docIds_t news;
+            for (std::size_t i = 0; i < predictions.size(); ++i) {
+                auto id = _ids[i + startFrom];
+                if (predictions[i].news) {
+                    news.emplace_back(id);
+                    if (_heads.hasCategory()) {
+                        m_categories[id] = predictions[i].category;
+                    }
+                } else {
+                    _docTable.vectorRows[id] = docTable_t::noVector;
+                }
             }
+
+            std::unique_lock<std::mutex> lck(m_mtx);
+            auto &langNews = m_langVecSet.at(_langCode);
+            langNews.insert(langNews.end(), news.begin(), news.end());
         }
     } catch (const std::exception &_e) {
         std::cerr << _e.what() << std::endl;
@@ -15,13 +15,23 @@
 #include "types.h"
 
 class embedder_t;
+class heads_t;
+class chunkScheduler_t;
+class docCache_t;
 
+// Embeds documents and detects news. If category models are given, news and category heads of a language are
+// evaluated as one fused layer (heads_t), so every vector row is read once for both.
 class newsCluster_t {
 public:
+    // _categoryLangModelFileNames - empty if categories are not needed
     newsCluster_t(uint8_t _threads,
                   const std::unordered_map<std::string, std::string> &_w2vLangModelFileNames,
+                  const embedderSettings_t &_embedderSettings,
                   const std::unordered_map<std::string, std::string> &_newsLangModelFileNames,
-                  const langDocSet_t &_langDocSet);
+                  const std::unordered_map<std::string, std::string> &_categoryLangModelFileNames,
+                  docTable_t &_docTable,
+                  const langDocSet_t &_langDocSet,
+                  docCache_t *_docCache = nullptr);
     ~newsCluster_t();
 
     newsCluster_t(const newsCluster_t &) = delete;
@@ -29,19 +39,26 @@ public:
     newsCluster_t(const newsCluster_t &&) = delete;
     void operator=(const newsCluster_t &&) = delete;
 
+    // news by language, their vectors are stored to the document table
     const langVecSet_t &langVecSet() noexcept {return m_langVecSet;}
+    // categories of news by document id, empty if category models are not given
+    const std::vector<categories_t> &categories() noexcept {return m_categories;}
 
 private:
     langVecSet_t m_langVecSet;
+    std::vector<categories_t> m_categories;
     std::mutex m_mtx;
     std::map<std::string, std::unique_ptr<embedder_t>> m_embedder;
+    docCache_t *m_docCache = nullptr;
 
-    void worker(uint8_t _thrID,
-                uint8_t _threads,
+    // first _embed documents of _ids are embedded, the rest have cached vectors; _rows[i] is the vector row of _ids[i]
+    void worker(chunkScheduler_t &_scheduler,
                 const std::string &_langCode,
-                const std::string &_newsLangModelFileName,
-                const std::vector<std::string> &_fileNames,
-                const std::vector<document_t> &_documents) noexcept;
+                const heads_t &_heads,
+                docTable_t &_docTable,
+                const docIds_t &_ids,
+                const std::vector<uint32_t> &_rows,
+                std::size_t _embed) noexcept;
 };
 
 #endif //TGNEWS_NEWSCLUSTER_H
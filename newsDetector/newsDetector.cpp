@@ -5,40 +5,85 @@
  * @date 25.02.2020
 */
 
+#include <cmath>
+#include <iostream>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif
+#include <dlib/dnn.h>
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
 #include "newsDetector.h"
 
+struct newsDetector_t::net_t {
+    using binaryLabelNet_t = dlib::loss_binary_log<
+    dlib::fc<1,
+            dlib::input<dlib::matrix<float>>
+    >>;
+
+    binaryLabelNet_t binaryLabelNet;
+
+    // the network keeps the state of its forward pass, a copy is evaluated, so threads share nothing mutable
+    [[nodiscard]] bool classify(const float *_vector, std::size_t _size) const {
+        auto net = binaryLabelNet;
+        std::vector<dlib::matrix<float>> samples(1);
+        samples[0].set_size(1, static_cast<long>(_size));
+        for (std::size_t j = 0; j < _size; ++j) {
+            samples[0](j) = _vector[j];
+        }
+        return (net(samples)[0] > 0.0f);
+    }
+};
+
 newsDetector_t::newsDetector_t(const std::string &_newsModelFileName) {
-    m_binaryLabelNet = std::make_unique<binaryLabelNet_t>();
-    dlib::deserialize(_newsModelFileName) >> *m_binaryLabelNet;
+    auto net = std::make_shared<net_t>();
+    dlib::deserialize(_newsModelFileName) >> net->binaryLabelNet;
+    m_layer = linearLayer_t::fc(dlib::layer<1>(net->binaryLabelNet).layer_details());
+    if (m_layer.outputs() != 1) {
+        throw std::runtime_error("newsDetector_t: wrong number of model outputs");
+    }
+    m_net = std::move(net);
 }
 
 newsDetector_t::~newsDetector_t() = default;
 
-void newsDetector_t::operator()(const std::vector<std::vector<float>> &_vectors,
-                                std::size_t _startFrom, std::size_t _stopAt,
-                                std::vector<bool> &_result) noexcept {
+void newsDetector_t::operator()(const matrix_t &_vectors,
+                               std::size_t _startFrom, std::size_t _stopAt,
+                               std::vector<bool> &_result) const noexcept {
     if (_vectors.empty()) {
         return;
     }
 
     try {
-        dlib::matrix<float> matrix;
-        auto vSize = _vectors.begin()->size();
-        matrix.set_size(1, vSize);
-        std::vector<dlib::matrix<float>> samples(_stopAt - _startFrom, matrix);
-        std::size_t pos = 0;
+        _result.resize(_stopAt - _startFrom);
         for (auto i = _startFrom; i < _stopAt; ++i) {
-            for (std::size_t j = 0; j < vSize; ++j) {
-                samples[pos](j) = _vectors[i][j];
-            }
-            pos++;
+            _result[i - _startFrom] = classify(_vectors.row(i));
         }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+    }
+}
+
+void newsDetector_t::operator()(const matrix_t &_vectors,
+                               const std::vector<uint32_t> &_rows,
+                               std::size_t _startFrom, std::size_t _stopAt,
+                               std::vector<bool> &_result) const noexcept {
+    if (_startFrom >= _stopAt) {
+        return;
+    }
 
-        auto prediction = (*m_binaryLabelNet)(samples);
-        auto rSize = prediction.size();
-        _result.resize(rSize);
-        for (std::size_t i = 0; i < rSize; ++i) {
-            _result[i] = (prediction[i] > 0.0f);
+    try {
+        _result.resize(_stopAt - _startFrom);
+        for (auto i = _startFrom; i < _stopAt; ++i) {
+            _result[i - _startFrom] = classify(_vectors.row(_rows[i]));
         }
     } catch (const std::exception &_e) {
         std::cerr << _e.what() << std::endl;
@@ -46,3 +91,18 @@ void newsDetector_t::operator()(const std::vector<std::vector<float>> &_vectors,
         std::cerr << "unknown error" << std::endl;
     }
 }
+
+heads_t::newsReference_t newsDetector_t::reference() const {
+    return [net = m_net, size = m_layer.inputs()](const float *_vector) {
+        return net->classify(_vector, size);
+    };
+}
+
+bool newsDetector_t::classify(const float *_vector) const {
+    float logit = 0.0f;
+    m_layer(_vector, &logit);
+    if (std::fabs(logit) < heads_t::tieMargin) {
+        return m_net->classify(_vector, m_layer.inputs());
+    }
+    return (logit > 0.0f);
+}
@@ -9,36 +9,44 @@
 #ifndef TGNEWS_NEWSDETECTOR_H
 #define TGNEWS_NEWSDETECTOR_H
 
-#include <vector>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
-#if defined(__clang__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
-#pragma clang diagnostic ignored "-Wunused-parameter"
-#pragma clang diagnostic ignored "-Wextra-semi"
-#endif
-#include <dlib/dnn.h>
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif
+#include "vecMath/matrix.h"
+#include "inference/linearLayer.h"
+#include "inference/heads.h"
 
+// The dlib binary classifier is a single fc layer, its weights are extracted at load and evaluated by linearLayer_t,
+// the decision (news if the logit is positive) is the same as of the dlib network: logits within heads_t::tieMargin
+// of zero are decided by the network itself.
 class newsDetector_t {
 public:
     explicit newsDetector_t(const std::string &_newsModelFileName);
     ~newsDetector_t();
 
-    void operator()(const std::vector<std::vector<float>> &_vectors,
+    // classifies rows [_startFrom, _stopAt) of _vectors
+    void operator()(const matrix_t &_vectors,
+                    std::size_t _startFrom, std::size_t _stopAt,
+                    std::vector<bool> &_result) const noexcept;
+    // classifies rows _rows[i] of _vectors, i = [_startFrom, _stopAt)
+    void operator()(const matrix_t &_vectors,
+                    const std::vector<uint32_t> &_rows,
                     std::size_t _startFrom, std::size_t _stopAt,
-                    std::vector<bool> &_result) noexcept;
+                    std::vector<bool> &_result) const noexcept;
+
+    [[nodiscard]] const linearLayer_t &layer() const noexcept {return m_layer;}
+    // decision of the dlib network, shares the network and outlives the detector
+    [[nodiscard]] heads_t::newsReference_t reference() const;
 
 private:
-    using binaryLabelNet_t = dlib::loss_binary_log<
-    dlib::fc<1,
-            dlib::input<dlib::matrix<float>>
-    >>;
+    struct net_t;
+
+    std::shared_ptr<const net_t> m_net;
+    linearLayer_t m_layer;
 
-    std::unique_ptr<binaryLabelNet_t> m_binaryLabelNet;
+    [[nodiscard]] bool classify(const float *_vector) const;
 };
 
 #endif //TGNEWS_NEWSDETECTOR_H
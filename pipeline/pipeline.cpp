@@ -0,0 +1,435 @@
+/**
+ * @file pipeline/pipeline.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstring>
+#include <thread>
+#include <stdexcept>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#endif
+#include <cld_3/nnet_language_identifier.h>
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include "dataLoader/mappedFile.h"
+#include "dataLoader/textExtractor.h"
+#include "embedder/embedder.h"
+#include "newsDetector/newsDetector.h"
+#include "categorizer/categorizer.h"
+#include "inference/heads.h"
+#include "pipeline.h"
+
+// heap memory of the document fields, which are dropped after embedding
+static inline std::size_t textBytes(const document_t &_document) noexcept {
+    return _document.site.size() + _document.title.size() + _document.text.size();
+}
+
+// only the name and the title are needed for the output
+static inline void dropText(document_t &_document) {
+    std::string().swap(_document.text);
+    std::string().swap(_document.site);
+}
+
+pipeline_t::pipeline_t(uint8_t _threads,
+                       cmd_t _cmd,
+                       const pipelineSettings_t &_settings,
+                       const std::vector<std::string> &_langCodes,
+                       const std::unordered_map<std::string, std::string> &_w2vLangModelFileNames,
+                       const embedderSettings_t &_embedderSettings,
+                       const std::unordered_map<std::string, std::string> &_newsLangModelFileNames,
+                       const std::unordered_map<std::string, std::string> &_categoryLangModelFileNames,
+                       const std::unordered_map<categories_t, std::string> &_categoryNames,
+                       htmlParser_t _htmlParser,
+                       bool _ioUring,
+                       char *const *_path):
+        m_lastStage((_cmd == cmd_t::LNG)?stage_t::LANG:((_cmd == cmd_t::NWS)?stage_t::NEWS:stage_t::CATEGORY)),
+        m_allLangs(_cmd == cmd_t::LNG),
+        m_htmlParser(_htmlParser),
+        m_ioUring(_ioUring),
+        m_memoryBudget(_settings.memoryBudget),
+        m_fileQueue(_settings.queueSize),
+        m_parsedQueue(_settings.queueSize),
+        m_langQueue(_settings.queueSize),
+        m_embeddedQueue(_settings.queueSize),
+        m_newsQueue(_settings.queueSize) {
+    if (!m_allLangs) {
+        for (const auto &s:_langCodes) {
+            m_langDocSet.emplace(s, docIds_t());
+        }
+    }
+
+    if (m_lastStage != stage_t::LANG) {
+        for (const auto &wm:_w2vLangModelFileNames) {
+            auto newsLangModelItr = _newsLangModelFileNames.find(wm.first);
+            if (newsLangModelItr == _newsLangModelFileNames.end()) {
+                throw std::runtime_error("news detection model file is not defined for language \""
+                                         + wm.first + "\"");
+            }
+            auto categoryLangModelItr = _categoryLangModelFileNames.find(wm.first);
+            if ((m_lastStage == stage_t::CATEGORY) && (categoryLangModelItr == _categoryLangModelFileNames.end())) {
+                throw std::runtime_error("category detection model file is not defined for language \""
+                                         + wm.first + "\"");
+            }
+            auto &embedder = m_embedder.emplace(wm.first,
+                                                std::make_unique<embedder_t>(wm.second, _embedderSettings))
+                    .first->second;
+
+            newsDetector_t newsDetector(newsLangModelItr->second);
+            auto &heads = m_heads[wm.first];
+            if (m_lastStage == stage_t::CATEGORY) {
+                categorizer_t categorizer(categoryLangModelItr->second);
+                heads = std::make_unique<heads_t>(newsDetector.layer(), categorizer.layer(), linearLayer_t(),
+                                                  newsDetector.reference(), categorizer.reference());
+            } else {
+                heads = std::make_unique<heads_t>(newsDetector.layer(), linearLayer_t(), linearLayer_t(),
+                                                  newsDetector.reference());
+            }
+            if (heads->inputs() != embedder->vectorSize()) {
+                throw std::runtime_error("news detection model does not match w2v model for language \""
+                                         + wm.first + "\"");
+            }
+            m_langVecSet.emplace(wm.first, docIds_t());
+        }
+    }
+
+    if (m_lastStage == stage_t::CATEGORY) {
+        for (const auto &cn:_categoryNames) {
+            m_groupSet.emplace(cn.first, docIds_t());
+        }
+    }
+
+    auto workers = [_threads](uint8_t _stageWorkers) {
+        return (_stageWorkers == 0)?((_threads == 0)?1:_threads):_stageWorkers;
+    };
+    std::vector<std::thread> parsers;
+    std::vector<std::thread> langDetectors;
+    std::vector<std::thread> embedders;
+    std::vector<std::thread> newsDetectors;
+    std::vector<std::thread> categorizers;
+    for (int i = 0; i < workers(_settings.parsers); ++i) {
+        parsers.emplace_back(std::thread(&pipeline_t::parseWorker, this));
+    }
+    for (int i = 0; i < workers(_settings.langDetectors); ++i) {
+        langDetectors.emplace_back(std::thread(&pipeline_t::langWorker, this));
+    }
+    if (m_lastStage != stage_t::LANG) {
+        for (int i = 0; i < workers(_settings.embedders); ++i) {
+            embedders.emplace_back(std::thread(&pipeline_t::embedWorker, this));
+        }
+        for (int i = 0; i < workers(_settings.newsDetectors); ++i) {
+            newsDetectors.emplace_back(std::thread(&pipeline_t::newsWorker, this));
+        }
+    }
+    if (m_lastStage == stage_t::CATEGORY) {
+        for (int i = 0; i < workers(_settings.categorizers); ++i) {
+            categorizers.emplace_back(std::thread(&pipeline_t::categoryWorker, this));
+        }
+    }
+
+    // every stage is closed when all its producers are done, so consumers drain their queues and exit
+    auto drain = [&]() {
+        m_fileQueue.close();
+        for (auto &i:parsers) {
+            i.join();
+        }
+        m_parsedQueue.close();
+        for (auto &i:langDetectors) {
+            i.join();
+        }
+        m_langQueue.close();
+        for (auto &i:embedders) {
+            i.join();
+        }
+        m_embeddedQueue.close();
+        for (auto &i:newsDetectors) {
+            i.join();
+        }
+        m_newsQueue.close();
+        for (auto &i:categorizers) {
+            i.join();
+        }
+    };
+
+    try {
+        // directories are walked in parallel, parsers start with the first batch
+        dataLoader_t::enumerate(_threads, _settings.batchSize, _path, [this](inputBatch_t &&_batch) {
+            // archive members are read to memory, files on disk are loaded by parsers
+            std::size_t bytes = 0;
+            for (const auto &c:_batch.contents) {
+                bytes += c.size();
+            }
+            if (!m_memoryBudget.acquire(bytes) || !m_fileQueue.push(std::move(_batch))) {
+                throw std::runtime_error("pipeline is stopped");
+            }
+        });
+    } catch (...) {
+        drain();
+        // the walk is stopped by a failed worker, its error is the cause
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+        throw;
+    }
+
+    drain();
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+pipeline_t::~pipeline_t() = default;
+
+void pipeline_t::parseWorker() noexcept {
+    try {
+        textExtractor_t te(m_htmlParser);
+        mappedFile_t body;
+        std::unique_ptr<uringReader_t> reader;
+        if (m_ioUring) {
+            reader = std::make_unique<uringReader_t>();
+        }
+        dataLoader_t::loadStat_t loadStat;
+
+        inputBatch_t fileBatch;
+        while (m_fileQueue.pop(fileBatch)) {
+            docBatch_t docBatch;
+            dataLoader_t::loadFiles(fileBatch, reader.get(), body, loadStat,
+                                    [&](std::size_t _idx, const uint8_t *_data, std::size_t _size) {
+                const auto &f = fileBatch.files[_idx];
+                document_t data;
+                data.name = f.second;
+                if (te(_data, _size, data)) {
+                    docBatch.bytes += textBytes(data);
+                    docBatch.fileNames.emplace_back(f.first + f.second);
+                    docBatch.documents.emplace_back(std::move(data));
+                }
+            });
+            std::size_t inputBytes = 0;
+            for (const auto &c:fileBatch.contents) {
+                inputBytes += c.size();
+            }
+            fileBatch = inputBatch_t();
+            if (inputBytes > 0) {
+                // the texts take over the reservation of the archive members, waiting here could deadlock:
+                // queued members hold the budget and only parsers release it
+                m_memoryBudget.exchange(inputBytes, docBatch.bytes);
+            } else if (!docBatch.documents.empty() && !m_memoryBudget.acquire(docBatch.bytes)) {
+                break;
+            }
+
+            if (!docBatch.documents.empty()) {
+                m_parsedQueue.push(std::move(docBatch));
+            }
+        }
+
+        std::unique_lock<std::mutex> lck(m_mtx);
+        m_loadStat += loadStat;
+    } catch (...) {
+        fail();
+    }
+}
+
+void pipeline_t::langWorker() noexcept {
+    try {
+        std::unique_ptr<chrome_lang_id::NNetLanguageIdentifier> lang_id;
+        {
+            std::unique_lock<std::mutex> lck(m_mtx);
+            lang_id = std::make_unique<chrome_lang_id::NNetLanguageIdentifier>(0, 1024);
+        }
+
+        docBatch_t parsed;
+        while (m_parsedQueue.pop(parsed)) {
+            std::map<std::string, docBatch_t> langBatches;
+            for (std::size_t i = 0; i < parsed.documents.size(); ++i) {
+                const auto &data = parsed.documents[i];
+                std::string doc(data.title);
+                if (!data.text.empty()) {
+                    if (doc.empty()) {
+                        doc = data.text;
+                    } else {
+                        doc += ". " + data.text;
+                    }
+                }
+                if (doc.empty()) {
+                    continue;
+                }
+
+                const chrome_lang_id::NNetLanguageIdentifier::Result r = lang_id->FindLanguage(doc);
+                if (!m_allLangs && (m_langDocSet.find(r.language) == m_langDocSet.end())) {
+                    continue;
+                }
+                auto &lb = langBatches[r.language];
+                lb.bytes += textBytes(data);
+                lb.fileNames.emplace_back(std::move(parsed.fileNames[i]));
+                lb.documents.emplace_back(std::move(parsed.documents[i]));
+            }
+
+            // rejected documents are freed here
+            std::size_t passed = 0;
+            for (const auto &lb:langBatches) {
+                passed += lb.second.bytes;
+            }
+            auto rejected = parsed.bytes - passed;
+            parsed = docBatch_t();
+            m_memoryBudget.release(rejected);
+
+            for (auto &lb:langBatches) {
+                if (m_lastStage == stage_t::LANG) {
+                    for (auto &d:lb.second.documents) {
+                        dropText(d);
+                    }
+                    {
+                        std::unique_lock<std::mutex> lck(m_mtx);
+                        auto &ids = m_langDocSet[lb.first];
+                        for (std::size_t i = 0; i < lb.second.documents.size(); ++i) {
+                            ids.emplace_back(m_docTable.add(std::move(lb.second.fileNames[i]),
+                                                            std::move(lb.second.documents[i])));
+                        }
+                    }
+                    m_memoryBudget.release(lb.second.bytes);
+                } else {
+                    lb.second.langCode = lb.first;
+                    m_langQueue.push(std::move(lb.second));
+                }
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+}
+
+void pipeline_t::embedWorker() noexcept {
+    try {
+        docBatch_t batch;
+        while (m_langQueue.pop(batch)) {
+            auto emi = m_embedder.find(batch.langCode);
+            if (emi != m_embedder.end()) {
+                (*emi->second)(batch.documents, 0, batch.documents.size(), batch.vectors);
+            }
+
+            // texts are not needed anymore, names and titles of news are kept for the output
+            for (auto &d:batch.documents) {
+                dropText(d);
+            }
+            m_memoryBudget.release(batch.bytes);
+            batch.bytes = 0;
+
+            if (!batch.vectors.empty()) {
+                m_embeddedQueue.push(std::move(batch));
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+}
+
+void pipeline_t::newsWorker() noexcept {
+    try {
+        docBatch_t batch;
+        while (m_embeddedQueue.pop(batch)) {
+            const auto &heads = *m_heads.at(batch.langCode);
+            std::vector<heads_t::prediction_t> predictions;
+            heads(batch.vectors, 0, batch.vectors.rows(), predictions);
+
+            // keep news only
+            std::size_t news = 0;
+            for (std::size_t i = 0; i < predictions.size(); ++i) {
+                if (!predictions[i].news) {
+                    continue;
+                }
+                if (news != i) {
+                    batch.fileNames[news] = std::move(batch.fileNames[i]);
+                    batch.documents[news] = std::move(batch.documents[i]);
+                    std::memcpy(batch.vectors.row(news), batch.vectors.row(i), batch.vectors.cols() * sizeof(float));
+                }
+                batch.categories.emplace_back(predictions[i].category);
+                ++news;
+            }
+            if (news == 0) {
+                continue;
+            }
+            batch.vectors.resize(news, batch.vectors.cols());
+
+            {
+                std::unique_lock<std::mutex> lck(m_mtx);
+                auto &ids = m_langDocSet.at(batch.langCode);
+                for (std::size_t i = 0; i < news; ++i) {
+                    batch.ids.emplace_back(m_docTable.add(std::move(batch.fileNames[i]),
+                                                          std::move(batch.documents[i])));
+                }
+                ids.insert(ids.end(), batch.ids.begin(), batch.ids.end());
+            }
+            batch.fileNames.clear();
+            batch.documents.clear();
+
+            if (m_lastStage == stage_t::NEWS) {
+                storeVectors(batch, batch.vectors.rows());
+            } else {
+                m_newsQueue.push(std::move(batch));
+            }
+        }
+    } catch (...) {
+        fail();
+    }
+}
+
+void pipeline_t::categoryWorker() noexcept {
+    try {
+        docBatch_t batch;
+        while (m_newsQueue.pop(batch)) {
+            {
+                std::unique_lock<std::mutex> lck(m_mtx);
+                for (std::size_t i = 0; i < batch.categories.size(); ++i) {
+                    m_groupSet.at(batch.categories[i]).emplace_back(batch.ids[i]);
+                }
+            }
+            storeVectors(batch, batch.categories.size());
+        }
+    } catch (...) {
+        fail();
+    }
+}
+
+void pipeline_t::fail() noexcept {
+    {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        if (!m_error) {
+            m_error = std::current_exception();
+        }
+    }
+
+    // nobody may be left waiting for a stage that has no workers anymore
+    m_memoryBudget.cancel();
+    m_fileQueue.close();
+    m_parsedQueue.close();
+    m_langQueue.close();
+    m_embeddedQueue.close();
+    m_newsQueue.close();
+}
+
+void pipeline_t::storeVectors(docBatch_t &_batch, std::size_t _size) {
+    std::unique_lock<std::mutex> lck(m_mtx);
+    auto &news = m_langVecSet.at(_batch.langCode);
+    if (m_docTable.vectors.empty()) {
+        m_docTable.vectors.resize(0, _batch.vectors.cols());
+    }
+    for (std::size_t i = 0; i < _size; ++i) {
+        m_docTable.vectorRows[_batch.ids[i]] = static_cast<uint32_t>(m_docTable.vectors.append(_batch.vectors.row(i)));
+        news.emplace_back(_batch.ids[i]);
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file pipeline/pipeline.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_PIPELINE_H
+#define TGNEWS_PIPELINE_H
+
+#include <memory>
+#include <mutex>
+#include <map>
+#include <exception>
+
+#include "types.h"
+#include "scheduler/boundedQueue.h"
+#include "scheduler/memoryBudget.h"
+#include "dataLoader/dataLoader.h"
+
+class embedder_t;
+class heads_t;
+
+// Streaming alternative to dataLoader_t -> newsCluster_t -> categoryCluster_t phases.
+// Batches of documents flow through bounded queues: parse -> language detection -> embedding ->
+// news detection -> categorizing, each stage has its own workers, so all stages run concurrently.
+// News and categories are predicted by the news stage in one pass (heads_t), the category stage groups the news.
+// Document texts are dropped as soon as they are embedded, only names and titles of the output documents and
+// vectors of news are retained. Input contents and texts in flight are limited by the memory budget.
+class pipeline_t {
+public:
+    pipeline_t(uint8_t _threads,
+               cmd_t _cmd,
+               const pipelineSettings_t &_settings,
+               const std::vector<std::string> &_langCodes,
+               const std::unordered_map<std::string, std::string> &_w2vLangModelFileNames,
+               const embedderSettings_t &_embedderSettings,
+               const std::unordered_map<std::string, std::string> &_newsLangModelFileNames,
+               const std::unordered_map<std::string, std::string> &_categoryLangModelFileNames,
+               const std::unordered_map<categories_t, std::string> &_categoryNames,
+               htmlParser_t _htmlParser,
+               bool _ioUring,
+               char *const *_path);
+    ~pipeline_t();
+
+    pipeline_t(const pipeline_t &) = delete;
+    void operator=(const pipeline_t &) = delete;
+    pipeline_t(const pipeline_t &&) = delete;
+    void operator=(const pipeline_t &&) = delete;
+
+    const docTable_t &docTable() noexcept {return m_docTable;}
+    const langDocSet_t &langDocSet() noexcept {return m_langDocSet;}
+    const langVecSet_t &langVecSet() noexcept {return m_langVecSet;}
+    const groupSet_t &groupSet() noexcept {return m_groupSet;}
+    [[nodiscard]] const dataLoader_t::loadStat_t &loadStat() const noexcept {return m_loadStat;}
+    // max bytes of input contents and document texts held in flight at once
+    [[nodiscard]] std::size_t peakInFlight() {return m_memoryBudget.peak();}
+
+private:
+    using inputBatch_t = dataLoader_t::inputBatch_t;
+
+    struct docBatch_t {
+        std::string langCode;
+        std::vector<std::string> fileNames;
+        std::vector<document_t> documents;
+        // ids of the documents stored to the table, file names and documents are moved there
+        docIds_t ids;
+        // a row by document, one allocation by batch
+        matrix_t vectors;
+        // categories of news, predicted together with the news flags
+        std::vector<categories_t> categories;
+        // bytes acquired from the memory budget
+        std::size_t bytes = 0;
+    };
+
+    enum class stage_t {
+        LANG,
+        NEWS,
+        CATEGORY
+    };
+
+    const stage_t m_lastStage;
+    const bool m_allLangs;
+    const htmlParser_t m_htmlParser;
+    const bool m_ioUring;
+
+    std::map<std::string, std::unique_ptr<embedder_t>> m_embedder;
+    // news and, if categories are needed, category heads by language, shared by the workers
+    std::map<std::string, std::unique_ptr<heads_t>> m_heads;
+
+    memoryBudget_t m_memoryBudget;
+
+    boundedQueue_t<inputBatch_t> m_fileQueue;
+    boundedQueue_t<docBatch_t> m_parsedQueue;
+    boundedQueue_t<docBatch_t> m_langQueue;
+    boundedQueue_t<docBatch_t> m_embeddedQueue;
+    boundedQueue_t<docBatch_t> m_newsQueue;
+
+    docTable_t m_docTable;
+    langDocSet_t m_langDocSet;
+    langVecSet_t m_langVecSet;
+    groupSet_t m_groupSet;
+    dataLoader_t::loadStat_t m_loadStat;
+    // the first error of a worker, rethrown by the constructor
+    std::exception_ptr m_error;
+    std::mutex m_mtx;
+
+    void parseWorker() noexcept;
+    void langWorker() noexcept;
+    void embedWorker() noexcept;
+    void newsWorker() noexcept;
+    void categoryWorker() noexcept;
+
+    // called by a failed worker: keeps the error, closes all queues and cancels the memory budget
+    void fail() noexcept;
+
+    void storeVectors(docBatch_t &_batch, std::size_t _size);
+};
+
+#endif //TGNEWS_PIPELINE_H
@@ -0,0 +1,107 @@
+/**
+ * @file pipeline/pipelineBudgetTest.cpp
+ * @brief a tar input larger than the memory budget passes the pipeline, no deadlock between loading and parsing
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "pipeline.h"
+
+static const std::size_t members = 256;
+static const std::size_t memoryBudget = 8 * 1024;
+
+// ustar member header, 512 bytes
+static std::string tarHeader(const std::string &_name, std::size_t _size) {
+    std::string ret(512, '\0');
+    std::memcpy(&ret[0], _name.data(), _name.size());
+    std::snprintf(&ret[100], 8, "%07o", 0644);
+    std::snprintf(&ret[108], 8, "%07o", 0);
+    std::snprintf(&ret[116], 8, "%07o", 0);
+    std::snprintf(&ret[124], 12, "%011zo", _size);
+    std::snprintf(&ret[136], 12, "%011o", 0);
+    ret[156] = '0';
+    std::memcpy(&ret[257], "ustar\0" "00", 8);
+    std::memset(&ret[148], ' ', 8);
+    unsigned int sum = 0;
+    for (auto c:ret) {
+        sum += static_cast<unsigned char>(c);
+    }
+    std::snprintf(&ret[148], 8, "%06o", sum);
+
+    return ret;
+}
+
+static std::string html(std::size_t _idx) {
+    std::string ret = "<html><head><meta property=\"og:title\" content=\"Document " + std::to_string(_idx)
+                      + "\"/></head><body>";
+    for (int i = 0; i < 16; ++i) {
+        ret += "<p>The quick brown fox jumps over the lazy dog, paragraph " + std::to_string(i) + ".</p>";
+    }
+    ret += "</body></html>";
+
+    return ret;
+}
+
+int main() {
+    char dir[] = "/tmp/pipelineBudgetTest.XXXXXX";
+    if (mkdtemp(dir) == nullptr) {
+        std::cerr << "failed to create a temporary directory" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto tarName = std::string(dir) + "/input.tar";
+    std::size_t inputBytes = 0;
+    {
+        std::ofstream ofs(tarName, std::ios::binary | std::ios::trunc);
+        for (std::size_t i = 0; i < members; ++i) {
+            auto content = html(i);
+            inputBytes += content.size();
+            ofs << tarHeader(std::to_string(i) + ".html", content.size()) << content
+                << std::string((512 - content.size() % 512) % 512, '\0');
+        }
+        ofs << std::string(1024, '\0');
+    }
+
+    int ret = EXIT_SUCCESS;
+    try {
+        pipelineSettings_t settings;
+        settings.enabled = true;
+        settings.queueSize = 1;
+        settings.batchSize = 4;
+        settings.parsers = 2;
+        settings.langDetectors = 1;
+        settings.memoryBudget = memoryBudget;
+
+        char *paths[] = {tarName.data(), nullptr};
+        pipeline_t pipeline(2, cmd_t::LNG, settings, {}, {}, embedderSettings_t(), {}, {}, {},
+                            htmlParser_t::SCANNER, false, paths);
+
+        std::cout << inputBytes << " bytes of input, " << memoryBudget << " bytes budget, "
+                  << pipeline.docTable().size() << " of " << members << " documents, "
+                  << pipeline.peakInFlight() << " bytes peak in flight" << std::endl;
+        if (pipeline.docTable().size() != members) {
+            std::cerr << "documents are lost" << std::endl;
+            ret = EXIT_FAILURE;
+        }
+        if (pipeline.peakInFlight() >= inputBytes) {
+            std::cerr << "the memory budget is not applied" << std::endl;
+            ret = EXIT_FAILURE;
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+        ret = EXIT_FAILURE;
+    }
+
+    std::remove(tarName.c_str());
+    rmdir(dir);
+
+    return ret;
+}
@@ -15,19 +15,20 @@
 
 struct extDocAttr_t: public document_t {
     std::size_t weight = 0;
-    std::vector<float> vector;
+    // row of the category vectors matrix, not copied
+    const float *vector = nullptr;
 
     extDocAttr_t(std::string _name,
                  std::string _site,
                  std::string _title,
                  uint64_t _time,
                  std::size_t _weight,
-                 std::vector<float> &_vector): document_t(std::move(_name),
-                                                          std::move(_site),
-                                                          std::move(_title),
-                                                          _time),
-                                               weight(_weight),
-                                               vector(std::move(_vector)) {}
+                 const float *_vector): document_t(std::move(_name),
+                                                   std::move(_site),
+                                                   std::move(_title),
+                                                   _time),
+                                        weight(_weight),
+                                        vector(_vector) {}
 };
 
 struct extCluster_t {
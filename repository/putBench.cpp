@@ -0,0 +1,135 @@
+/**
+ * @file repository/putBench.cpp
+ * @brief PUT requests throughput by the number of concurrent workers
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dataLoader/fileEnumerator.h"
+#include "repository.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 8) {
+        std::cerr << "usage: " << argv[0]
+                  << " db_file lang_code w2v_model news_model category_model weight_model html_dir [workers ...]"
+                  << std::endl
+                  << "  db_file - a scratch copy of db/tgnews.sqlite, documents are stored to it" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<unsigned int> workers;
+    for (int i = 8; i < argc; ++i) {
+        workers.emplace_back(std::stoul(argv[i]));
+    }
+    if (workers.empty()) {
+        workers = {1, 2, 4, 8, 16};
+    }
+
+    try {
+        // requests are served from memory, the file system is not measured
+        std::vector<std::vector<uint8_t>> bodies;
+        {
+            std::mutex mtx;
+            char *const paths[] = {argv[7], nullptr};
+            fileEnumerator_t enumerator(4, 256);
+            enumerator(paths, [&](fileEnumerator_t::fileBatch_t &&_batch) {
+                for (const auto &i:_batch) {
+                    std::ifstream ifs(i.first + i.second, std::ios::binary);
+                    std::vector<uint8_t> body((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+                    std::unique_lock<std::mutex> lck(mtx);
+                    bodies.emplace_back(std::move(body));
+                }
+            });
+        }
+        if (bodies.empty()) {
+            std::cerr << "no documents found" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::string langCode(argv[2]);
+        std::unordered_map<categories_t, std::string> categoryNames {
+                {categories_t::SOCIETY, "society"},
+                {categories_t::ECONOMY, "economy"},
+                {categories_t::TECHNOLOGY, "technology"},
+                {categories_t::SPORTS, "sports"},
+                {categories_t::ENTERTAINMENT, "entertainment"},
+                {categories_t::SCIENCE, "science"},
+                {categories_t::OTHER, "other"}
+        };
+        repository_t repository(1, {langCode},
+                                {{langCode, argv[3]}},
+                                embedderSettings_t(),
+                                {{langCode, argv[4]}},
+                                {{langCode, argv[5]}},
+                                {{langCode, argv[6]}},
+                                categoryNames,
+                                {{langCode, 0.9f}},
+                                argv[1],
+                                {{langCode, std::string(argv[1]) + "." + langCode + ".d2v"}},
+                                htmlParser_t::GUMBO);
+
+        std::cout << bodies.size() << " documents" << std::endl
+                  << std::setw(8) << "workers" << std::setw(12) << "PUT/s" << std::setw(10) << "speedup"
+                  << std::setw(10) << "created" << std::setw(10) << "ignored" << std::setw(10) << "failed"
+                  << std::endl;
+        double single = 0.0;
+        for (std::size_t round = 0; round < workers.size(); ++round) {
+            std::atomic<std::size_t> requests {0};
+            std::atomic<std::size_t> created {0};
+            std::atomic<std::size_t> ignored {0};
+            std::atomic<std::size_t> failed {0};
+            auto started = std::chrono::steady_clock::now();
+            auto stopAt = started + std::chrono::seconds(5);
+
+            std::vector<std::thread> thrPool;
+            for (unsigned int w = 0; w < workers[round]; ++w) {
+                thrPool.emplace_back([&] {
+                    std::string description;
+                    while (std::chrono::steady_clock::now() < stopAt) {
+                        auto i = requests++;
+                        // names are unique, every document is stored as a new one
+                        auto name = std::to_string(round) + "_" + std::to_string(i) + ".html";
+                        auto status = repository_t::onPut(name, 86400, bodies[i % bodies.size()], description,
+                                                          &repository);
+                        if ((status == 201) || (status == 204)) {
+                            ++created;
+                        } else if (status == 202) {
+                            ++ignored;
+                        } else {
+                            ++failed;
+                        }
+                    }
+                });
+            }
+            for (auto &i:thrPool) {
+                i.join();
+            }
+
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+            auto rate = static_cast<double>(created + ignored + failed) / elapsed.count();
+            if (round == 0) {
+                single = rate / workers[round];
+            }
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(8) << workers[round] << std::setw(12) << rate
+                      << std::setw(10) << rate / single << std::setw(10) << created
+                      << std::setw(10) << ignored << std::setw(10) << failed << std::endl;
+        }
+    } catch (const std::exception &_e) {
+        std::cerr << _e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
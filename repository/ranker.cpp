@@ -5,15 +5,35 @@
  * @date 25.05.2020
 */
 
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif
+#include <dlib/dnn.h>
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+
 #include "types.h"
 #include "ranker.h"
 
 ranker_t::ranker_t(const std::string &_weightModelFileName) {
-    m_langWeightNet = std::make_unique<weightNet_t>();
-    dlib::deserialize(_weightModelFileName) >> *m_langWeightNet;
+    using weightNet_t = dlib::loss_mean_squared<
+            dlib::fc<1,
+                    dlib::input<dlib::matrix<float>>
+            >>;
+
+    weightNet_t weightNet;
+    dlib::deserialize(_weightModelFileName) >> weightNet;
+    m_weightLayer = linearLayer_t::fc(dlib::layer<1>(weightNet).layer_details());
+    if (m_weightLayer.outputs() != 1) {
+        throw std::runtime_error("ranker_t: wrong number of model outputs");
+    }
 }
 
-float ranker_t::operator()(const extCluster_t &_cluster, std::size_t _records) {
+float ranker_t::operator()(const extCluster_t &_cluster, std::size_t _records) const {
     if (_cluster.extDocAttrs.empty()) {
         return 0.0f;
     }
@@ -21,32 +41,12 @@ float ranker_t::operator()(const extCluster_t &_cluster, std::size_t _records) {
     auto weightMark = 0.0f;
 // TODO: train model on more samples
 /*
-    thread_local auto weightNet = *m_langWeightNet;
-    try {
-        dlib::matrix<float> matrix;
-        auto vSize = _cluster.extDocAttrs.begin()->vector.size();
-        matrix.set_size(1, vSize);
-        std::vector<dlib::matrix<float>> samples(_cluster.extDocAttrs.size(), matrix);
-        std::size_t pos = 0;
-        for (std::size_t i = 0; i < samples.size(); ++i) {
-            for (std::size_t j = 0; j < vSize; ++j) {
-                samples[pos](j) = _cluster.extDocAttrs[i].vector[j];
-            }
-            pos++;
+    for (const auto &i:_cluster.extDocAttrs) {
+        float weight = 0.0f;
+        m_weightLayer(i.vector, &weight);
+        if ((weight <= 0.8f) and (weight >= 0.0f) and (weightMark < weight)) {
+            weightMark = weight;
         }
-
-        auto prediction = weightNet(samples);
-        for (const auto &i:prediction) {
-            if ((i <= 0.8f) and (i >= 0.0f) and (weightMark < i)) {
-                weightMark = i;
-            }
-        }
-    } catch (const std::exception &_e) {
-        std::cerr << _e.what() << std::endl;
-        return 0.0f;
-    } catch (...) {
-        std::cerr << "unknown error" << std::endl;
-        return 0.0f;
     }
 */
     float categoryMark = 0.0f;
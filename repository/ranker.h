@@ -9,19 +9,10 @@
 #ifndef TGNEWS_RANKER_H
 #define TGNEWS_RANKER_H
 
+#include <string>
 #include <vector>
 
-#if defined(__clang__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
-#pragma clang diagnostic ignored "-Wunused-parameter"
-#pragma clang diagnostic ignored "-Wextra-semi"
-#endif
-#include <dlib/dnn.h>
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif
-
+#include "inference/linearLayer.h"
 #include "extDocAttr.h"
 
 class ranker_t {
@@ -29,15 +20,13 @@ public:
     explicit ranker_t(const std::string &_weightModelFileName);
     ~ranker_t() = default;
 
-    float operator()(const extCluster_t &_cluster, std::size_t _records);
+    float operator()(const extCluster_t &_cluster, std::size_t _records) const;
 
-private:
-    using weightNet_t = dlib::loss_mean_squared<
-            dlib::fc<1,
-                    dlib::input<dlib::matrix<float>>
-            >>;
+    // weight regression model, a single fc layer extracted from the dlib network
+    [[nodiscard]] const linearLayer_t &layer() const noexcept {return m_weightLayer;}
 
-    std::unique_ptr<weightNet_t> m_langWeightNet;
+private:
+    linearLayer_t m_weightLayer;
 };
 
 #endif //TGNEWS_RANKER_H
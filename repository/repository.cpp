@@ -6,6 +6,7 @@
 */
 
 #include <chrono>
+#include <iostream>
 
 #include <word2vec.hpp>
 
@@ -47,6 +48,7 @@
 #include "embedder/embedder.h"
 #include "newsDetector/newsDetector.h"
 #include "categorizer/categorizer.h"
+#include "inference/heads.h"
 #include "dbscan/dbscan.h"
 #include "extDocAttr.h"
 #include "ranker.h"
@@ -60,18 +62,18 @@ repository_t::dataProcessing_t::~dataProcessing_t() = default;
 repository_t::repository_t(uint8_t _threads,
                            const std::vector<std::string> &_langCodes,
                            const std::unordered_map<std::string, std::string> &_w2vFileNames,
+                           const embedderSettings_t &_embedderSettings,
                            const std::unordered_map<std::string, std::string> &_newsDetectionModels,
                            const std::unordered_map<std::string, std::string> &_categoryDetectionModels,
                            const std::unordered_map<std::string, std::string> &_weightDetectionModels,
                            const std::unordered_map<categories_t, std::string> &_categoryNames,
                            const std::unordered_map<std::string, float> &_similarityThreshold,
                            const std::string &_sqliteFileName,
-                           const std::unordered_map<std::string, std::string> &_indexFileNames):
-        m_threads(_threads), m_categoryNames(_categoryNames) {
+                           const std::unordered_map<std::string, std::string> &_indexFileNames,
+                           htmlParser_t _htmlParser):
+        m_threads(_threads), m_htmlParser(_htmlParser), m_categoryNames(_categoryNames) {
 
     std::cout << "repository loading..." << std::endl;
-    m_langIdentifier = std::make_unique<chrome_lang_id::NNetLanguageIdentifier>(0, 1024);
-
     m_sqliteClient = std::make_unique<sqliteClient_t>(_sqliteFileName);
 
     for (std::size_t i = 0; i < _langCodes.size(); ++i) {
@@ -92,21 +94,21 @@ repository_t::repository_t(uint8_t _threads,
         if (w2vfn == _w2vFileNames.end()) {
             throw std::runtime_error("embedding model file is not defined for language \"" + lc + "\"");
         }
-        dp->second->embedder = std::make_unique<embedder_t>(w2vfn->second);
+        dp->second->embedder = std::make_unique<embedder_t>(w2vfn->second, _embedderSettings);
         std::cout << "repository loading: embedding model is loaded" << std::endl;
 
         const auto ndm = _newsDetectionModels.find(lc);
         if (ndm == _newsDetectionModels.end()) {
             throw std::runtime_error("news detection model file is not defined for language \"" + lc + "\"");
         }
-        dp->second->newsDetector = std::make_unique<newsDetector_t>(ndm->second);
+        newsDetector_t newsDetector(ndm->second);
         std::cout << "repository loading: news detection model is loaded" << std::endl;
 
         const auto cdm = _categoryDetectionModels.find(lc);
         if (cdm == _categoryDetectionModels.end()) {
             throw std::runtime_error("category detection model file is not defined for language \"" + lc + "\"");
         }
-        dp->second->categorizer = std::make_unique<categorizer_t>(cdm->second);
+        categorizer_t categorizer(cdm->second);
         std::cout << "repository loading: categorizing model is loaded" << std::endl;
 
         const auto wdm = _weightDetectionModels.find(lc);
@@ -116,6 +118,13 @@ repository_t::repository_t(uint8_t _threads,
         dp->second->ranker = std::make_unique<ranker_t>(wdm->second);
         std::cout << "repository loading: weight model is loaded" << std::endl;
 
+        dp->second->heads = std::make_unique<heads_t>(newsDetector.layer(), categorizer.layer(),
+                                                      dp->second->ranker->layer(),
+                                                      newsDetector.reference(), categorizer.reference());
+        if (dp->second->heads->inputs() != dp->second->embedder->vectorSize()) {
+            throw std::runtime_error("models input size differs from the vector size for language \"" + lc + "\"");
+        }
+
         const auto sth = _similarityThreshold.find(lc);
         if (sth == _similarityThreshold.end()) {
             throw std::runtime_error("similarity threshold value is not defined for language \"" + lc + "\"");
@@ -160,7 +169,7 @@ uint16_t repository_t::onPut(const std::string &_name,
         // text extraction from HTML
         document_t doc;
         {
-            textExtractor_t textExtractor;
+            textExtractor_t textExtractor(repository->m_htmlParser);
             if (!textExtractor(_data, doc)) {
                 _description = "Internal Server Error";
                 return 500;
@@ -184,11 +193,13 @@ uint16_t repository_t::onPut(const std::string &_name,
                 return 204;
             }
 
-            chrome_lang_id::NNetLanguageIdentifier::Result r;
-            {
+            // the identifier is not thread safe, every worker thread has its own one
+            thread_local std::unique_ptr<chrome_lang_id::NNetLanguageIdentifier> langIdentifier;
+            if (!langIdentifier) {
                 std::unique_lock<std::mutex> lck(repository->m_langIdentifierMtx);
-                r = repository->m_langIdentifier->FindLanguage(text);
+                langIdentifier = std::make_unique<chrome_lang_id::NNetLanguageIdentifier>(0, 1024);
             }
+            auto r = langIdentifier->FindLanguage(text);
             auto l = repository->m_dataProcessingSet.find(r.language);
             if (l == repository->m_dataProcessingSet.end()) {
                 _description = "Ignored";
@@ -199,41 +210,22 @@ uint16_t repository_t::onPut(const std::string &_name,
         }
 
         // embedding
-        std::vector<std::vector<float>> docVecs;
+        matrix_t docVecs;
         {
             std::vector<document_t> dv{doc};
             (*repository->m_dataProcessingSet.at(langCode)->embedder)(dv, 0, 1, docVecs);
-            if (docVecs.size() != 1) {
-                _description = "Ignored";
-                return 202; // correct reply
-            }
-        }
-
-        // news detection
-        {
-            std::vector<bool> result;
-            {
-                std::unique_lock<std::mutex> lck(repository->m_dataProcessingSet.at(langCode)->newsDetectorMtx);
-                (*repository->m_dataProcessingSet.at(langCode)->newsDetector)(docVecs, 0, 1, result);
-            }
-            if ((result.size() != 1) || !result[0]) {
+            if (docVecs.rows() != 1) {
                 _description = "Ignored";
                 return 202; // correct reply
             }
         }
 
-        // categorizing
-        std::vector<categories_t> categories;
-        {
-            {
-                std::unique_lock<std::mutex> lck(repository->m_dataProcessingSet.at(langCode)->categorizerMtx);
-                (*repository->m_dataProcessingSet.at(langCode)->categorizer)(docVecs, 0, 1, categories);
-            }
-            if (categories.size() != 1) {
-                _description = "Ignored";
-                return 202; // correct reply
-            }
-
+        // news detection and categorizing, one pass of the fused heads, weights are read only
+        heads_t::prediction_t prediction;
+        (*repository->m_dataProcessingSet.at(langCode)->heads)(docVecs.row(0), prediction);
+        if (!prediction.news) {
+            _description = "Ignored";
+            return 202; // correct reply
         }
 
         uint64_t id = ++(repository->m_dataProcessingSet.at(langCode)->lastId);
@@ -242,7 +234,7 @@ uint16_t repository_t::onPut(const std::string &_name,
                 std::make_tuple(
                         id,
                         langID,
-                        static_cast<uint8_t>(categories[0]),
+                        static_cast<uint8_t>(prediction.category),
                         _name,
                         doc.title,
                         doc.site,
@@ -251,7 +243,8 @@ uint16_t repository_t::onPut(const std::string &_name,
                 result
         );
 
-        w2v::vector_t vector(docVecs[0]);
+        std::vector<float> docVec(docVecs.row(0), docVecs.row(0) + docVecs.cols());
+        w2v::vector_t vector(docVec);
         {
             std::unique_lock lck(repository->m_dataProcessingSet.at(langCode)->indexMtx);
             if (std::get<0>(result) != 0) {
@@ -358,11 +351,16 @@ uint16_t repository_t::onGet(uint32_t _period,
         return 500;
     }
 
-    // document vectors grouped by categories
-    std::map<categories_t, std::vector<std::vector<float>>> docVecByCategory;
+    // document vectors grouped by categories, a matrix by category
+    std::map<categories_t, matrix_t> docVecByCategory;
     // result indices  grouped by categories
     std::map<categories_t, std::vector<std::size_t>> resultIdxByCategory;
     { // fill out docVecByCategory & resultIdxByCategory arrays
+        // matrix rows are allocated at once
+        std::map<categories_t, std::size_t> categorySize;
+        for (const auto &r:result) {
+            ++categorySize[static_cast<categories_t>(std::get<1>(r))];
+        }
         std::shared_lock lck(dataProcessingIter->second->indexMtx);
         for (std::size_t i = 0; i < result.size(); ++i) {
             const auto tmpVec = dataProcessingIter->second->index->vector(std::get<0>(result[i]));
@@ -373,10 +371,10 @@ uint16_t repository_t::onGet(uint32_t _period,
 
             auto dvc = docVecByCategory.find(c);
             if (dvc == docVecByCategory.end()) {
-                docVecByCategory.emplace(c, std::vector<std::vector<float>>(1, *tmpVec));
-            } else {
-                dvc->second.emplace_back(*tmpVec);
+                dvc = docVecByCategory.emplace(c, matrix_t(0, tmpVec->size())).first;
+                dvc->second.reserve(categorySize[c]);
             }
+            dvc->second.append(tmpVec->data());
 
             auto ric = resultIdxByCategory.find(c);
             if (ric == resultIdxByCategory.end()) {
@@ -418,7 +416,7 @@ uint16_t repository_t::onGet(uint32_t _period,
                     std::get<3>(result[ric->second[std::get<1>(j)]]),
                     std::get<5>(result[ric->second[std::get<1>(j)]]),
                     std::get<2>(j),
-                    ci->second[std::get<1>(j)]));
+                    ci->second.row(std::get<1>(j))));
         }
 
         std::size_t maxclustersize = 0;
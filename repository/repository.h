@@ -8,6 +8,7 @@
 #ifndef TGNEWS_REPOSITORY_H
 #define TGNEWS_REPOSITORY_H
 
+#include <mutex>
 #include <shared_mutex>
 #include <atomic>
 #include <thread>
@@ -24,8 +25,7 @@ namespace w2v {
 
 class sqliteClient_t;
 class embedder_t;
-class newsDetector_t;
-class categorizer_t;
+class heads_t;
 class ranker_t;
 class repository_t {
 
@@ -33,13 +33,15 @@ public:
     repository_t(uint8_t _threads,
                  const std::vector<std::string> &_langCodes,
                  const std::unordered_map<std::string, std::string> &_w2vFileNames,
+                 const embedderSettings_t &_embedderSettings,
                  const std::unordered_map<std::string, std::string> &_newsDetectionModels,
                  const std::unordered_map<std::string, std::string> &_categoryDetectionModels,
                  const std::unordered_map<std::string, std::string> &_weightDetectionModels,
                  const std::unordered_map<categories_t, std::string> &_categoryNames,
                  const std::unordered_map<std::string, float> &_similarityThreshold,
                  const std::string &_sqliteFileName,
-                 const std::unordered_map<std::string, std::string> &_indexFileNames);
+                 const std::unordered_map<std::string, std::string> &_indexFileNames,
+                 htmlParser_t _htmlParser);
     ~repository_t();
 
     static uint16_t onPut(const std::string &_name,
@@ -62,11 +64,8 @@ private:
 
         std::unique_ptr<embedder_t> embedder;
 
-        std::unique_ptr<newsDetector_t> newsDetector;
-        std::mutex newsDetectorMtx;
-
-        std::unique_ptr<categorizer_t> categorizer;
-        std::mutex categorizerMtx;
+        // news and category (and weight) models, immutable, shared by the PUT workers without locking
+        std::unique_ptr<heads_t> heads;
 
         std::unique_ptr<ranker_t> ranker;
 
@@ -88,9 +87,10 @@ private:
     };
 
     const uint8_t m_threads;
+    const htmlParser_t m_htmlParser;
     const std::unordered_map<categories_t, std::string> &m_categoryNames;
 
-    std::unique_ptr<chrome_lang_id::NNetLanguageIdentifier> m_langIdentifier;
+    // language identifiers are created by thread, the construction is serialized
     std::mutex m_langIdentifierMtx;
 
     std::unique_ptr<sqliteClient_t> m_sqliteClient;
@@ -0,0 +1,73 @@
+/**
+ * @file scheduler/boundedQueue.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_BOUNDEDQUEUE_H
+#define TGNEWS_BOUNDEDQUEUE_H
+
+#include <cstddef>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+
+// multi-producer/multi-consumer FIFO queue, producers are blocked while the queue is full
+template<typename T>
+class boundedQueue_t final {
+public:
+    explicit boundedQueue_t(std::size_t _capacity): m_capacity((_capacity > 0)?_capacity:1) {}
+
+    boundedQueue_t(const boundedQueue_t &) = delete;
+    void operator=(const boundedQueue_t &) = delete;
+
+    // returns false if the queue is closed
+    bool push(T &&_item) {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        m_cvNotFull.wait(lck, [this] {return m_closed || (m_queue.size() < m_capacity);});
+        if (m_closed) {
+            return false;
+        }
+        m_queue.push(std::move(_item));
+        lck.unlock();
+        m_cvNotEmpty.notify_one();
+
+        return true;
+    }
+
+    // returns false if the queue is closed and there are no more items
+    bool pop(T &_item) {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        m_cvNotEmpty.wait(lck, [this] {return m_closed || !m_queue.empty();});
+        if (m_queue.empty()) {
+            return false;
+        }
+        _item = std::move(m_queue.front());
+        m_queue.pop();
+        lck.unlock();
+        m_cvNotFull.notify_one();
+
+        return true;
+    }
+
+    // consumers drain the remaining items, producers are rejected
+    void close() {
+        {
+            std::unique_lock<std::mutex> lck(m_mtx);
+            m_closed = true;
+        }
+        m_cvNotEmpty.notify_all();
+        m_cvNotFull.notify_all();
+    }
+
+private:
+    const std::size_t m_capacity;
+    std::queue<T> m_queue;
+    bool m_closed = false;
+    std::mutex m_mtx;
+    std::condition_variable m_cvNotEmpty;
+    std::condition_variable m_cvNotFull;
+};
+
+#endif //TGNEWS_BOUNDEDQUEUE_H
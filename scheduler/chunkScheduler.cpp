@@ -0,0 +1,33 @@
+/**
+ * @file scheduler/chunkScheduler.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <algorithm>
+
+#include "chunkScheduler.h"
+
+chunkScheduler_t::chunkScheduler_t(std::size_t _size, uint8_t _threads, std::size_t _minChunk) noexcept:
+        m_size(_size),
+        m_workers((_threads == 0)?1:static_cast<uint8_t>(std::min<std::size_t>(_threads,
+                                                                                 std::max<std::size_t>(_size, 1)))),
+        m_minChunk(std::max<std::size_t>(_minChunk, 1)) {
+}
+
+bool chunkScheduler_t::next(std::size_t &_startFrom, std::size_t &_stopAt) noexcept {
+    auto cursor = m_cursor.load(std::memory_order_relaxed);
+    while (cursor < m_size) {
+        // every worker takes a half of its fair share of the remaining items
+        auto chunk = std::max((m_size - cursor) / (2 * m_workers), m_minChunk);
+        auto stopAt = std::min(cursor + chunk, m_size);
+        if (m_cursor.compare_exchange_weak(cursor, stopAt, std::memory_order_relaxed)) {
+            _startFrom = cursor;
+            _stopAt = stopAt;
+            return true;
+        }
+    }
+
+    return false;
+}
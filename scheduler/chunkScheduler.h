@@ -0,0 +1,39 @@
+/**
+ * @file scheduler/chunkScheduler.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_CHUNKSCHEDULER_H
+#define TGNEWS_CHUNKSCHEDULER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+// Dispatches [0, size) index range between worker threads by chunks via a shared atomic cursor.
+// Chunk size decreases while the range is being consumed (guided scheduling), so large chunks amortize
+// per-chunk overhead at the beginning, and small chunks at the end keep all threads busy until the last item.
+class chunkScheduler_t final {
+public:
+    chunkScheduler_t(std::size_t _size, uint8_t _threads, std::size_t _minChunk = 1) noexcept;
+
+    chunkScheduler_t(const chunkScheduler_t &) = delete;
+    void operator=(const chunkScheduler_t &) = delete;
+
+    // returns false when there are no more items to process
+    bool next(std::size_t &_startFrom, std::size_t &_stopAt) noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept {return m_size;}
+    // number of workers worth to be started
+    [[nodiscard]] uint8_t workers() const noexcept {return m_workers;}
+
+private:
+    const std::size_t m_size;
+    const uint8_t m_workers;
+    const std::size_t m_minChunk;
+    std::atomic<std::size_t> m_cursor {0};
+};
+
+#endif //TGNEWS_CHUNKSCHEDULER_H
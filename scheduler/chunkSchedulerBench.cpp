@@ -0,0 +1,135 @@
+/**
+ * @file scheduler/chunkSchedulerBench.cpp
+ * @brief fixed slices vs guided chunks on a skewed cost distribution, completion time p50, p99 and makespan
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chunkScheduler.h"
+
+using steadyClock_t = std::chrono::steady_clock;
+
+// item costs in microseconds, Pareto distributed as file sizes of a crawl: most are small, a few are huge
+static std::vector<double> costs(std::size_t _items, bool _clustered) {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> ret(_items);
+    for (auto &i:ret) {
+        // alpha 1.5, min 50us, capped at 100ms
+        i = std::min(50.0 / std::pow(1.0 - uniform(generator), 1.0 / 1.5), 100000.0);
+    }
+    if (_clustered) {
+        // large files grouped together, as in a directory of one site
+        std::sort(ret.begin(), ret.begin() + static_cast<long>(_items / 4), std::greater<>());
+    }
+
+    return ret;
+}
+
+// spins for _us, or sleeps if there are less cores than threads
+static void work(double _us, bool _sleep) {
+    auto stopAt = steadyClock_t::now() + std::chrono::duration<double, std::micro>(_us);
+    if (_sleep) {
+        std::this_thread::sleep_until(stopAt);
+        return;
+    }
+    while (steadyClock_t::now() < stopAt) {
+    }
+}
+
+struct result_t {
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double makespan = 0.0;
+};
+
+// completion time of every item from the start, ms
+template<typename worker_t>
+static result_t run(std::size_t _items, unsigned int _threads, const worker_t &_worker) {
+    std::vector<double> completed(_items);
+    auto started = steadyClock_t::now();
+    std::vector<std::thread> thrPool;
+    for (unsigned int t = 0; t < _threads; ++t) {
+        thrPool.emplace_back([&, t] {
+            _worker(t, [&](std::size_t _idx) {
+                completed[_idx] = std::chrono::duration<double, std::milli>(steadyClock_t::now() - started).count();
+            });
+        });
+    }
+    for (auto &i:thrPool) {
+        i.join();
+    }
+
+    result_t ret;
+    ret.makespan = std::chrono::duration<double, std::milli>(steadyClock_t::now() - started).count();
+    if (_items == 0) {
+        return ret;
+    }
+    std::sort(completed.begin(), completed.end());
+    ret.p50 = completed[_items / 2];
+    ret.p99 = completed[std::min(_items - 1, _items * 99 / 100)];
+
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    if ((argc > 1) && (std::string(argv[1]) == "-h")) {
+        std::cerr << "usage: " << argv[0] << " [threads] [items] [spin|sleep]" << std::endl
+                  << "  sleep - items are slept, not spun, for machines with less cores than threads" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto threads = (argc > 1)?static_cast<unsigned int>(std::stoul(argv[1])):std::thread::hardware_concurrency();
+    threads = std::clamp(threads, 1u, 255u);
+    std::size_t items = (argc > 2)?std::stoull(argv[2]):4000;
+    bool sleep = (argc > 3) && (std::string(argv[3]) == "sleep");
+
+    std::cout << threads << " threads, " << items << " items, " << (sleep?"sleep":"spin") << std::endl
+              << std::setw(12) << "costs" << std::setw(10) << "schedule"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(12) << "makespan" << "  ms" << std::endl;
+    for (auto clustered:{false, true}) {
+        auto cost = costs(items, clustered);
+
+        // every thread processes its own contiguous slice
+        auto fixed = run(items, threads, [&](unsigned int _t, const auto &_done) {
+            auto slice = (items + threads - 1) / threads;
+            auto stopAt = std::min(items, (_t + 1) * slice);
+            for (auto i = _t * slice; i < stopAt; ++i) {
+                work(cost[i], sleep);
+                _done(i);
+            }
+        });
+
+        chunkScheduler_t scheduler(items, static_cast<uint8_t>(threads));
+        auto guided = run(items, threads, [&](unsigned int, const auto &_done) {
+            std::size_t startFrom = 0;
+            std::size_t stopAt = 0;
+            while (scheduler.next(startFrom, stopAt)) {
+                for (auto i = startFrom; i < stopAt; ++i) {
+                    work(cost[i], sleep);
+                    _done(i);
+                }
+            }
+        });
+
+        std::cout << std::fixed << std::setprecision(2);
+        for (const auto &r:{std::make_pair("fixed", fixed), std::make_pair("guided", guided)}) {
+            std::cout << std::setw(12) << (clustered?"clustered":"shuffled") << std::setw(10) << r.first
+                      << std::setw(10) << r.second.p50 << std::setw(10) << r.second.p99
+                      << std::setw(12) << r.second.makespan << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
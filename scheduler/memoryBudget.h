@@ -0,0 +1,94 @@
+/**
+ * @file scheduler/memoryBudget.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_MEMORYBUDGET_H
+#define TGNEWS_MEMORYBUDGET_H
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+// Counting semaphore of bytes: producers are blocked while the data they have already passed downstream exceeds
+// the budget, consumers release the bytes when the data is freed.
+// A request is always granted if nothing is held, so data larger than the budget does not stall the stream.
+class memoryBudget_t final {
+public:
+    // 0 - unlimited
+    explicit memoryBudget_t(std::size_t _budget) noexcept: m_budget(_budget) {}
+
+    memoryBudget_t(const memoryBudget_t &) = delete;
+    void operator=(const memoryBudget_t &) = delete;
+
+    // returns false if the budget is cancelled
+    bool acquire(std::size_t _bytes) {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        if (m_budget > 0) {
+            m_cv.wait(lck, [this, _bytes] {return m_cancelled || (m_held == 0) || (m_held + _bytes <= m_budget);});
+        }
+        if (m_cancelled) {
+            return false;
+        }
+        m_held += _bytes;
+        if (m_held > m_peak) {
+            m_peak = m_held;
+        }
+
+        return true;
+    }
+
+    void release(std::size_t _bytes) {
+        if (_bytes == 0) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lck(m_mtx);
+            m_held -= (_bytes < m_held)?_bytes:m_held;
+        }
+        m_cv.notify_all();
+    }
+
+    // replaces _held acquired bytes by _bytes without waiting, for data converted from the held one: a holder must not
+    // wait for the budget, the bytes it holds may be the ones it waits for
+    void exchange(std::size_t _held, std::size_t _bytes) {
+        {
+            std::unique_lock<std::mutex> lck(m_mtx);
+            m_held -= (_held < m_held)?_held:m_held;
+            m_held += _bytes;
+            if (m_held > m_peak) {
+                m_peak = m_held;
+            }
+        }
+        if (_bytes < _held) {
+            m_cv.notify_all();
+        }
+    }
+
+    // wakes and rejects all waiting and further requests, the stream is stopped
+    void cancel() {
+        {
+            std::unique_lock<std::mutex> lck(m_mtx);
+            m_cancelled = true;
+        }
+        m_cv.notify_all();
+    }
+
+    // max bytes held at once
+    [[nodiscard]] std::size_t peak() {
+        std::unique_lock<std::mutex> lck(m_mtx);
+        return m_peak;
+    }
+
+private:
+    const std::size_t m_budget;
+    std::size_t m_held = 0;
+    std::size_t m_peak = 0;
+    bool m_cancelled = false;
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+};
+
+#endif //TGNEWS_MEMORYBUDGET_H
@@ -23,12 +23,12 @@
 
 similarityCluster_t::similarityCluster_t(uint8_t _threads,
                                          const std::unordered_map<std::string, float> &_similarityThreshold,
+                                         const docTable_t &_docTable,
                                          const langVecSet_t &_langVecSet,
                                          const groupSet_t &_groupSet) {
-    std::unordered_map<std::string, std::unordered_map<std::string, categories_t>> catByLang;
     // iterate languages
     for (const auto &lv:_langVecSet) {
-        if (lv.second.empty() || lv.second.begin()->second.empty()) {
+        if (lv.second.empty() || !_docTable.hasVector(lv.second.front())) {
             continue;
         }
         // get threshold value for the language
@@ -42,6 +42,12 @@ similarityCluster_t::similarityCluster_t(uint8_t _threads,
             }
         }
 
+        // documents of the language
+        std::vector<bool> langDocs(_docTable.size(), false);
+        for (auto id:lv.second) {
+            langDocs[id] = true;
+        }
+
         // iterate categories
         dlib::parallel_for(_threads,
                            static_cast<std::size_t>(categories_t::SOCIETY),
@@ -53,27 +59,21 @@ similarityCluster_t::similarityCluster_t(uint8_t _threads,
                 return;
             }
 
-            std::vector<std::string> fileNames;
-            std::vector<std::vector<float>> vectors;
-            // iterate filenames (j = {file, lang})
-            for (const auto &j:ci->second) {
-                if (j.second != lv.first) {
-                    continue;
-                }
-                // find vector by file name
-                auto vi = lv.second.find(j.first);
-                if (vi == lv.second.end()) {
+            docIds_t ids;
+            std::vector<uint32_t> rows;
+            for (auto id:ci->second) {
+                if (!langDocs[id] || !_docTable.hasVector(id)) {
                     continue;
                 }
-                fileNames.push_back(j.first);
-                vectors.push_back(vi->second);
+                ids.push_back(id);
+                rows.push_back(_docTable.vectorRows[id]);
             }
-            dbscan_t dbscan(vectors, threshold, 32);
+            dbscan_t dbscan(_docTable.vectors, rows, threshold, 32);
 
             clusterSet_t tmpClusterSet(dbscan.size(), std::make_pair(cluster_t(), ci->first));
             for (const auto &j:dbscan()) {
                 // cluster id starts from 1
-                tmpClusterSet[std::get<0>(j) - 1].first.emplace_back(fileNames[std::get<1>(j)], lv.first);
+                tmpClusterSet[std::get<0>(j) - 1].first.emplace_back(ids[std::get<1>(j)]);
             }
 
             std::unique_lock<std::mutex> lck(m_mtx);
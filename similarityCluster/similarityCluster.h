@@ -16,6 +16,7 @@ class similarityCluster_t {
 public:
     similarityCluster_t(uint8_t _threads,
                         const std::unordered_map<std::string, float> &_similarityThreshold,
+                        const docTable_t &_docTable,
                         const langVecSet_t &_langVecSet,
                         const groupSet_t &_groupSet);
 
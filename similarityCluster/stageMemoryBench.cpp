@@ -0,0 +1,200 @@
+/**
+ * @file similarityCluster/stageMemoryBench.cpp
+ * @brief peak RSS and wall time of the news, category and similarity stages: copies of documents and vectors
+ * passed between the stages, as it was done before the document table, against the table ids and rows
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "vecMath/vecMath.h"
+#include "dbscan/dbscan.h"
+#include "categoryCluster/categoryCluster.h"
+#include "similarityCluster.h"
+
+static const std::size_t vectorSize = 512;
+// documents per chunk, as newsCluster_t schedules them
+static const std::size_t chunkSize = 64;
+static const float threshold = 0.895f;
+// texts and copied vectors are read, so their copies are not optimized out
+static volatile float sink = 0.0f;
+
+struct settings_t {
+    std::size_t documents = 20000;
+    std::size_t textSize = 2000;
+    // percents of documents detected as news
+    std::size_t newsShare = 50;
+};
+
+static std::size_t peakRss() {
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+// the embedder and the classifiers are simulated, so both modes get the same vectors, news and categories;
+// documents of a story are close to each other, as news of one event
+static void embed(docId_t _id, float *_vector) {
+    auto story = _id / 10;
+    std::mt19937 storyGenerator(story);
+    std::mt19937 generator(_id);
+    std::normal_distribution<float> distribution;
+    for (std::size_t j = 0; j < vectorSize; ++j) {
+        _vector[j] = distribution(storyGenerator) + 0.3f * distribution(generator);
+    }
+    vecMath_t::scale(_vector, vectorSize, 1.0f / std::sqrt(vecMath_t::sumOfSquares(_vector, vectorSize)));
+}
+
+static bool isNews(docId_t _id, const settings_t &_settings) {
+    return (_id / 10 * 2654435761u % 100) < _settings.newsShare;
+}
+
+static categories_t category(docId_t _id) {
+    return static_cast<categories_t>(_id / 10 % 7);
+}
+
+// documents as they are returned by the loader
+static docTable_t load(const settings_t &_settings) {
+    docTable_t ret;
+    for (std::size_t i = 0; i < _settings.documents; ++i) {
+        document_t document(std::to_string(i) + ".html", "site", "title " + std::to_string(i), 0);
+        document.text.assign(_settings.textSize, 'a' + static_cast<char>(i % 26));
+        ret.add("/data/" + document.name, std::move(document));
+    }
+
+    return ret;
+}
+
+// documents are copied per language, vectors are copied to langVecSet, to the categorizer input
+// and to the dbscan input of every category
+static std::size_t copies(docTable_t &_docTable, const settings_t &_settings) {
+    std::vector<std::vector<float>> tableVectors(_docTable.size());
+    docIds_t news;
+    {
+        std::vector<document_t> documents(_docTable.documents.begin(), _docTable.documents.end());
+        for (std::size_t startFrom = 0; startFrom < documents.size(); startFrom += chunkSize) {
+            std::vector<std::vector<float>> vectors;
+            for (auto i = startFrom; (i < startFrom + chunkSize) && (i < documents.size()); ++i) {
+                vectors.emplace_back(vectorSize);
+                embed(static_cast<docId_t>(i), vectors.back().data());
+                sink = sink + static_cast<float>(documents[i].text.empty()?0:documents[i].text.back());
+            }
+            for (std::size_t i = 0; i < vectors.size(); ++i) {
+                auto id = static_cast<docId_t>(startFrom + i);
+                if (isNews(id, _settings)) {
+                    tableVectors[id] = std::move(vectors[i]);
+                    news.emplace_back(id);
+                }
+            }
+        }
+    }
+
+    groupSet_t groupSet;
+    {
+        std::vector<std::vector<float>> vectors;
+        for (auto id:news) {
+            vectors.emplace_back(tableVectors[id]);
+            sink = sink + vectors.back().back();
+        }
+        for (auto id:news) {
+            groupSet[category(id)].emplace_back(id);
+        }
+    }
+
+    std::size_t clusters = 0;
+    for (auto i = static_cast<std::size_t>(categories_t::SOCIETY); i < static_cast<std::size_t>(categories_t::OTHER);
+         ++i) {
+        const auto ci = groupSet.find(static_cast<categories_t>(i));
+        if (ci == groupSet.end()) {
+            continue;
+        }
+        matrix_t vectors(0, vectorSize);
+        for (auto id:ci->second) {
+            vectors.append(tableVectors[id].data());
+        }
+        dbscan_t dbscan(vectors, threshold, 32);
+        clusters += dbscan.size();
+    }
+
+    return clusters;
+}
+
+// documents and vectors are referred by the table ids and rows, as the stages do
+static std::size_t views(docTable_t &_docTable, const settings_t &_settings) {
+    langVecSet_t langVecSet;
+    auto &news = langVecSet["en"];
+    std::vector<categories_t> categories(_docTable.size(), categories_t::OTHER);
+    _docTable.vectors.resize(_docTable.size(), vectorSize);
+    for (std::size_t startFrom = 0; startFrom < _docTable.size(); startFrom += chunkSize) {
+        for (auto i = startFrom; (i < startFrom + chunkSize) && (i < _docTable.size()); ++i) {
+            auto id = static_cast<docId_t>(i);
+            _docTable.vectorRows[id] = id;
+            embed(id, _docTable.vectors.row(id));
+            const auto &text = _docTable.documents[id].text;
+            sink = sink + static_cast<float>(text.empty()?0:text.back());
+            std::string().swap(_docTable.documents[id].text);
+            if (isNews(id, _settings)) {
+                news.emplace_back(id);
+                categories[id] = category(id);
+            } else {
+                _docTable.vectorRows[id] = docTable_t::noVector;
+            }
+        }
+    }
+    _docTable.shrinkVectors();
+
+    std::unordered_map<categories_t, std::string> categoryNames;
+    for (auto i = static_cast<std::size_t>(categories_t::SOCIETY); i <= static_cast<std::size_t>(categories_t::OTHER);
+         ++i) {
+        categoryNames.emplace(static_cast<categories_t>(i), std::to_string(i));
+    }
+    categoryCluster_t categoryCluster(categoryNames, langVecSet, categories);
+    similarityCluster_t similarityCluster(1, {{"en", threshold}}, _docTable, langVecSet,
+                                          categoryCluster.groupSet());
+
+    return similarityCluster.clusters().size();
+}
+
+int main(int argc, char *argv[]) {
+    if ((argc < 2) || ((std::string(argv[1]) != "copies") && (std::string(argv[1]) != "views"))) {
+        std::cerr << "usage: " << argv[0] << " copies|views [documents] [text_bytes] [news_percent]" << std::endl
+                  << "  peak RSS is per process, so modes are compared by separate runs" << std::endl;
+        return EXIT_FAILURE;
+    }
+    settings_t settings;
+    settings.documents = (argc > 2)?std::stoull(argv[2]):settings.documents;
+    settings.textSize = (argc > 3)?std::stoull(argv[3]):settings.textSize;
+    settings.newsShare = (argc > 4)?std::stoull(argv[4]):settings.newsShare;
+
+    auto docTable = load(settings);
+    auto loadedRss = peakRss();
+
+    auto started = std::chrono::steady_clock::now();
+    auto clusters = (std::string(argv[1]) == "copies")?copies(docTable, settings):views(docTable, settings);
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << std::fixed << std::setprecision(0)
+              << argv[1] << ": " << settings.documents << " documents, " << settings.textSize << " bytes of text, "
+              << settings.newsShare << "% news, " << clusters << " clusters" << std::endl
+              << "stages " << ms << " ms, peak RSS " << static_cast<double>(peakRss()) / (1024 * 1024)
+              << " MB, loaded documents " << static_cast<double>(loadedRss) / (1024 * 1024) << " MB" << std::endl;
+
+    return EXIT_SUCCESS;
+}
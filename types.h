@@ -8,10 +8,15 @@
 #ifndef TGNEWS_TYPES_H
 #define TGNEWS_TYPES_H
 
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <stdexcept>
 #include <vector>
 #include <unordered_map>
 
+#include "vecMath/matrix.h"
+
 // type of CLI command
 enum class cmd_t {
     LNG,
@@ -34,17 +39,74 @@ struct document_t {
             name(std::move(_name)), site(std::move(_site)), title(std::move(_title)), time(_time) {}
 };
 
-// file name and its parsed content
-using docSet_t = std::unordered_map<std::string, document_t>;
+// HTML parser used to extract document_t fields
+enum class htmlParser_t {
+    GUMBO,
+    // streaming scanner, falls back to Gumbo on unsupported markup
+    SCANNER,
+    // both parsers, mismatches are reported to stderr
+    VERIFY
+};
+
+// dense document identifier, a row of docTable_t
+using docId_t = uint32_t;
 
-// language code and its documents
-using langDocSet_t = std::unordered_map<std::string, docSet_t>;
+using docIds_t = std::vector<docId_t>;
+
+// documents of a CLI run stored by columns, stages refer to documents by their ids,
+// file names are resolved at the output only
+struct docTable_t {
+    // absolute file names
+    std::vector<std::string> fileNames;
+    std::vector<document_t> documents;
+    // embedding vectors of all documents in one matrix
+    matrix_t vectors;
+    // row of the document vector, noVector if a document is not embedded or is not a news
+    std::vector<uint32_t> vectorRows;
+
+    static constexpr uint32_t noVector = UINT32_MAX;
+
+    [[nodiscard]] std::size_t size() const noexcept {return documents.size();}
+    [[nodiscard]] bool hasVector(docId_t _id) const noexcept {return vectorRows[_id] != noVector;}
+    [[nodiscard]] const float *vector(docId_t _id) const noexcept {return vectors.row(vectorRows[_id]);}
+
+    docId_t add(std::string &&_fileName, document_t &&_document) {
+        if (documents.size() >= UINT32_MAX) {
+            throw std::runtime_error("too many documents");
+        }
+        fileNames.emplace_back(std::move(_fileName));
+        documents.emplace_back(std::move(_document));
+        vectorRows.emplace_back(noVector);
+        return static_cast<docId_t>(documents.size() - 1);
+    }
 
-// file name and its document victor
-using vecSet_t = std::unordered_map<std::string, std::vector<float>>;
+    // releases rows of documents without vectors (not news), one allocation
+    void shrinkVectors() {
+        std::size_t rows = 0;
+        for (auto r:vectorRows) {
+            rows += (r != noVector)?1:0;
+        }
+        if (rows == vectors.rows()) {
+            return;
+        }
+        matrix_t shrunk(rows, vectors.cols());
+        uint32_t row = 0;
+        for (auto &r:vectorRows) {
+            if (r == noVector) {
+                continue;
+            }
+            std::memcpy(shrunk.row(row), vectors.row(r), vectors.cols() * sizeof(float));
+            r = row++;
+        }
+        vectors = std::move(shrunk);
+    }
+};
+
+// language code and its documents
+using langDocSet_t = std::unordered_map<std::string, docIds_t>;
 
-// language code and its document vectors
-using langVecSet_t = std::unordered_map<std::string, vecSet_t>;
+// language code and its documents with vectors (news)
+using langVecSet_t = std::unordered_map<std::string, docIds_t>;
 
 enum class categories_t {
     SOCIETY = 0,
@@ -56,16 +118,38 @@ enum class categories_t {
     OTHER = 6
 };
 
-// category and its document file names
-using groupSet_t = std::unordered_map<categories_t, std::unordered_map<std::string, std::string>>;
-
-// file name and its language code
-using fileWithLang_t = std::pair<std::string, std::string>;
+// category and its documents
+using groupSet_t = std::unordered_map<categories_t, docIds_t>;
 
-// cluster and its files
-using cluster_t = std::vector<fileWithLang_t>;
+// cluster and its documents
+using cluster_t = docIds_t;
 
 // clusters set
 using clusterSet_t = std::vector<std::pair<cluster_t, categories_t>>;
 
+// embedding model settings
+struct embedderSettings_t {
+    // FAISS index: vectors of the most frequent words decoded at load, vectors of the rest are decoded from the index
+    // per token; 0 - all words
+    std::size_t decodedWords = 0;
+    // FAISS index: decoded vectors are stored as half precision floats
+    bool decodedFp16 = false;
+};
+
+// streaming pipeline mode settings, 0 workers means the number of threads passed to the CLI
+struct pipelineSettings_t {
+    bool enabled = false;
+    // queue capacity between stages, in batches
+    std::size_t queueSize = 0;
+    // documents per batch
+    std::size_t batchSize = 0;
+    uint8_t parsers = 0;
+    uint8_t langDetectors = 0;
+    uint8_t embedders = 0;
+    uint8_t newsDetectors = 0;
+    uint8_t categorizers = 0;
+    // input contents and document texts held in flight, in bytes, 0 - unlimited
+    std::size_t memoryBudget = 0;
+};
+
 #endif //TGNEWS_TYPES_H
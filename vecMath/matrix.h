@@ -0,0 +1,106 @@
+/**
+ * @file vecMath/matrix.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_MATRIX_H
+#define TGNEWS_MATRIX_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Row-major float matrix of embedding vectors, one allocation for all rows. Rows are cache line aligned and padded,
+// so every row is passed to the vecMath_t kernels as is. The storage grows geometrically, kept rows are preserved.
+class matrix_t final {
+public:
+    matrix_t() noexcept = default;
+    matrix_t(std::size_t _rows, std::size_t _cols) {resize(_rows, _cols);}
+    ~matrix_t() = default;
+
+    matrix_t(const matrix_t &) = delete;
+    void operator=(const matrix_t &) = delete;
+    matrix_t(matrix_t &&_other) noexcept {*this = std::move(_other);}
+    matrix_t &operator=(matrix_t &&_other) noexcept {
+        m_data = std::move(_other.m_data);
+        m_rows = std::exchange(_other.m_rows, 0);
+        m_cols = std::exchange(_other.m_cols, 0);
+        m_stride = std::exchange(_other.m_stride, 0);
+        m_capacity = std::exchange(_other.m_capacity, 0);
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t rows() const noexcept {return m_rows;}
+    [[nodiscard]] std::size_t cols() const noexcept {return m_cols;}
+    // floats between rows
+    [[nodiscard]] std::size_t stride() const noexcept {return m_stride;}
+    [[nodiscard]] bool empty() const noexcept {return m_rows == 0;}
+
+    [[nodiscard]] float *row(std::size_t _row) noexcept {return m_data.get() + _row * m_stride;}
+    [[nodiscard]] const float *row(std::size_t _row) const noexcept {return m_data.get() + _row * m_stride;}
+
+    // rows are kept if the number of columns is not changed, new rows are zeroed
+    void resize(std::size_t _rows, std::size_t _cols) {
+        if (_cols != m_cols) {
+            m_rows = 0;
+            m_cols = _cols;
+            m_stride = (_cols + rowAlignment - 1) / rowAlignment * rowAlignment;
+            m_capacity = 0;
+        }
+        reserve(_rows);
+        if (_rows > m_rows) {
+            std::memset(row(m_rows), 0, (_rows - m_rows) * m_stride * sizeof(float));
+        }
+        m_rows = _rows;
+    }
+    void reserve(std::size_t _rows) {
+        if (_rows > m_capacity) {
+            reallocate(std::max(_rows, m_capacity + m_capacity / 2));
+        }
+    }
+    // returns index of the new row
+    std::size_t append(const float *_row) {
+        reserve(m_rows + 1);
+        std::memcpy(row(m_rows), _row, m_cols * sizeof(float));
+        std::memset(row(m_rows) + m_cols, 0, (m_stride - m_cols) * sizeof(float));
+        return m_rows++;
+    }
+    void clear() noexcept {m_rows = 0;}
+
+private:
+    struct deleter_t {
+        void operator()(float *_ptr) const noexcept {std::free(_ptr);}
+    };
+
+    // floats, 64 bytes
+    static const std::size_t rowAlignment = 16;
+
+    std::unique_ptr<float[], deleter_t> m_data;
+    std::size_t m_rows = 0;
+    std::size_t m_cols = 0;
+    std::size_t m_stride = 0;
+    // allocated rows
+    std::size_t m_capacity = 0;
+
+    void reallocate(std::size_t _capacity) {
+        auto bytes = std::max<std::size_t>(_capacity * m_stride * sizeof(float), rowAlignment * sizeof(float));
+        std::unique_ptr<float[], deleter_t> data(static_cast<float *>(
+                std::aligned_alloc(rowAlignment * sizeof(float), bytes)));
+        if (!data) {
+            throw std::bad_alloc();
+        }
+        if (m_rows > 0) {
+            std::memcpy(data.get(), m_data.get(), m_rows * m_stride * sizeof(float));
+        }
+        m_data = std::move(data);
+        m_capacity = _capacity;
+    }
+};
+
+#endif //TGNEWS_MATRIX_H
@@ -0,0 +1,568 @@
+/**
+ * @file vecMath/vecMath.cpp
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TGNEWS_VECMATH_X86
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+
+#include "vecMath.h"
+
+namespace {
+    struct kernels_t {
+        vecMath_t::isa_t isa;
+        void (*accumulate)(float *, const float *, std::size_t) noexcept;
+        float (*sumOfSquares)(const float *, std::size_t) noexcept;
+        float (*dot)(const float *, const float *, std::size_t) noexcept;
+        void (*scale)(float *, std::size_t, float) noexcept;
+        void (*accumulateFp16)(float *, const uint16_t *, std::size_t) noexcept;
+        void (*accumulateInt8)(float *, const int8_t *, float, std::size_t) noexcept;
+        void (*gemv)(const float *, std::size_t, std::size_t, const float *, std::size_t, float *) noexcept;
+    };
+}
+
+static void accumulateScalar(float *_dst, const float *_src, std::size_t _size) noexcept {
+    for (std::size_t i = 0; i < _size; ++i) {
+        _dst[i] += _src[i];
+    }
+}
+
+static float dotScalar(const float *_l, const float *_r, std::size_t _size) noexcept {
+    auto ret = 0.0f;
+    for (std::size_t i = 0; i < _size; ++i) {
+        ret += _l[i] * _r[i];
+    }
+    return ret;
+}
+
+static float sumOfSquaresScalar(const float *_src, std::size_t _size) noexcept {
+    return dotScalar(_src, _src, _size);
+}
+
+static void scaleScalar(float *_dst, std::size_t _size, float _factor) noexcept {
+    for (std::size_t i = 0; i < _size; ++i) {
+        _dst[i] *= _factor;
+    }
+}
+
+static void accumulateFp16Scalar(float *_dst, const uint16_t *_src, std::size_t _size) noexcept {
+    for (std::size_t i = 0; i < _size; ++i) {
+        _dst[i] += vecMath_t::fromFp16(_src[i]);
+    }
+}
+
+static void accumulateInt8Scalar(float *_dst, const int8_t *_src, float _scale, std::size_t _size) noexcept {
+    for (std::size_t i = 0; i < _size; ++i) {
+        _dst[i] += static_cast<float>(_src[i]) * _scale;
+    }
+}
+
+static void gemvScalar(const float *_w, std::size_t _stride, std::size_t _rows,
+                       const float *_x, std::size_t _size, float *_y) noexcept {
+    for (std::size_t j = 0; j < _rows; ++j) {
+        _y[j] = dotScalar(_w + j * _stride, _x, _size);
+    }
+}
+
+using gemvBlock_t = void (*)(const float *, std::size_t, const float *, std::size_t, float *) noexcept;
+
+// rows are evaluated by blocks of 9, 4 and 1, every block is one pass over _x. Linear heads have 9 outputs (news,
+// categories, weight), 9 accumulators and _x fit the 16 vector registers.
+template<gemvBlock_t block9_t, gemvBlock_t block4_t, gemvBlock_t block1_t>
+static void gemvBlocks(const float *_w, std::size_t _stride, std::size_t _rows,
+                       const float *_x, std::size_t _size, float *_y) noexcept {
+    std::size_t j = 0;
+    for (; j + 9 <= _rows; j += 9) {
+        block9_t(_w + j * _stride, _stride, _x, _size, _y + j);
+    }
+    for (; j + 4 <= _rows; j += 4) {
+        block4_t(_w + j * _stride, _stride, _x, _size, _y + j);
+    }
+    for (; j < _rows; ++j) {
+        block1_t(_w + j * _stride, _stride, _x, _size, _y + j);
+    }
+}
+
+#ifdef TGNEWS_VECMATH_X86
+__attribute__((target("sse2")))
+static inline float hsum128(__m128 _v) noexcept {
+    auto shuf = _mm_shuffle_ps(_v, _v, _MM_SHUFFLE(2, 3, 0, 1));
+    auto sums = _mm_add_ps(_v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+
+__attribute__((target("sse2")))
+static void accumulateSse2(float *_dst, const float *_src, std::size_t _size) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= _size; i += 4) {
+        _mm_storeu_ps(_dst + i, _mm_add_ps(_mm_loadu_ps(_dst + i), _mm_loadu_ps(_src + i)));
+    }
+    for (; i < _size; ++i) {
+        _dst[i] += _src[i];
+    }
+}
+
+__attribute__((target("sse2")))
+static float dotSse2(const float *_l, const float *_r, std::size_t _size) noexcept {
+    auto acc0 = _mm_setzero_ps();
+    auto acc1 = _mm_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= _size; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(_l + i), _mm_loadu_ps(_r + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(_l + i + 4), _mm_loadu_ps(_r + i + 4)));
+    }
+    auto ret = hsum128(_mm_add_ps(acc0, acc1));
+    for (; i < _size; ++i) {
+        ret += _l[i] * _r[i];
+    }
+    return ret;
+}
+
+__attribute__((target("sse2")))
+static float sumOfSquaresSse2(const float *_src, std::size_t _size) noexcept {
+    return dotSse2(_src, _src, _size);
+}
+
+template<std::size_t rows_t>
+__attribute__((target("sse2")))
+static void gemvBlockSse2(const float *_w, std::size_t _stride, const float *_x, std::size_t _size,
+                          float *_y) noexcept {
+    __m128 acc[rows_t];
+#pragma GCC unroll 9
+    for (std::size_t j = 0; j < rows_t; ++j) {
+        acc[j] = _mm_setzero_ps();
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= _size; i += 4) {
+        auto x = _mm_loadu_ps(_x + i);
+#pragma GCC unroll 9
+        for (std::size_t j = 0; j < rows_t; ++j) {
+            acc[j] = _mm_add_ps(acc[j], _mm_mul_ps(_mm_loadu_ps(_w + j * _stride + i), x));
+        }
+    }
+    for (std::size_t j = 0; j < rows_t; ++j) {
+        _y[j] = hsum128(acc[j]) + dotScalar(_w + j * _stride + i, _x + i, _size - i);
+    }
+}
+
+__attribute__((target("sse2")))
+static void gemvRowSse2(const float *_w, std::size_t, const float *_x, std::size_t _size, float *_y) noexcept {
+    *_y = dotSse2(_w, _x, _size);
+}
+
+__attribute__((target("sse2")))
+static void scaleSse2(float *_dst, std::size_t _size, float _factor) noexcept {
+    auto factor = _mm_set1_ps(_factor);
+    std::size_t i = 0;
+    for (; i + 4 <= _size; i += 4) {
+        _mm_storeu_ps(_dst + i, _mm_mul_ps(_mm_loadu_ps(_dst + i), factor));
+    }
+    for (; i < _size; ++i) {
+        _dst[i] *= _factor;
+    }
+}
+
+// bytes are sign extended to 32 bits by unpacking them to the high bytes and shifting back
+__attribute__((target("sse2")))
+static void accumulateInt8Sse2(float *_dst, const int8_t *_src, float _scale, std::size_t _size) noexcept {
+    auto scale = _mm_set1_ps(_scale);
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + i));
+        auto lo = _mm_unpacklo_epi8(bytes, bytes);
+        auto hi = _mm_unpackhi_epi8(bytes, bytes);
+        const __m128i words[] = {_mm_unpacklo_epi16(lo, lo), _mm_unpackhi_epi16(lo, lo),
+                                 _mm_unpacklo_epi16(hi, hi), _mm_unpackhi_epi16(hi, hi)};
+        for (std::size_t j = 0; j < 4; ++j) {
+            auto values = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(words[j], 24)), scale);
+            _mm_storeu_ps(_dst + i + j * 4, _mm_add_ps(_mm_loadu_ps(_dst + i + j * 4), values));
+        }
+    }
+    accumulateInt8Scalar(_dst + i, _src + i, _scale, _size - i);
+}
+
+__attribute__((target("avx2,fma")))
+static void accumulateAvx2(float *_dst, const float *_src, std::size_t _size) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        _mm256_storeu_ps(_dst + i, _mm256_add_ps(_mm256_loadu_ps(_dst + i), _mm256_loadu_ps(_src + i)));
+        _mm256_storeu_ps(_dst + i + 8, _mm256_add_ps(_mm256_loadu_ps(_dst + i + 8), _mm256_loadu_ps(_src + i + 8)));
+    }
+    for (; i + 8 <= _size; i += 8) {
+        _mm256_storeu_ps(_dst + i, _mm256_add_ps(_mm256_loadu_ps(_dst + i), _mm256_loadu_ps(_src + i)));
+    }
+    for (; i < _size; ++i) {
+        _dst[i] += _src[i];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static float dotAvx2(const float *_l, const float *_r, std::size_t _size) noexcept {
+    // independent accumulators hide the FMA latency
+    auto acc0 = _mm256_setzero_ps();
+    auto acc1 = _mm256_setzero_ps();
+    auto acc2 = _mm256_setzero_ps();
+    auto acc3 = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 32 <= _size; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(_l + i), _mm256_loadu_ps(_r + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(_l + i + 8), _mm256_loadu_ps(_r + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(_l + i + 16), _mm256_loadu_ps(_r + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(_l + i + 24), _mm256_loadu_ps(_r + i + 24), acc3);
+    }
+    for (; i + 8 <= _size; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(_l + i), _mm256_loadu_ps(_r + i), acc0);
+    }
+    auto acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    auto ret = hsum128(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+    for (; i < _size; ++i) {
+        ret += _l[i] * _r[i];
+    }
+    return ret;
+}
+
+__attribute__((target("avx2,fma")))
+static float sumOfSquaresAvx2(const float *_src, std::size_t _size) noexcept {
+    return dotAvx2(_src, _src, _size);
+}
+
+template<std::size_t rows_t>
+__attribute__((target("avx2,fma")))
+static void gemvBlockAvx2(const float *_w, std::size_t _stride, const float *_x, std::size_t _size,
+                          float *_y) noexcept {
+    __m256 acc[rows_t];
+#pragma GCC unroll 9
+    for (std::size_t j = 0; j < rows_t; ++j) {
+        acc[j] = _mm256_setzero_ps();
+    }
+    std::size_t i = 0;
+    for (; i + 8 <= _size; i += 8) {
+        auto x = _mm256_loadu_ps(_x + i);
+#pragma GCC unroll 9
+        for (std::size_t j = 0; j < rows_t; ++j) {
+            acc[j] = _mm256_fmadd_ps(_mm256_loadu_ps(_w + j * _stride + i), x, acc[j]);
+        }
+    }
+    for (std::size_t j = 0; j < rows_t; ++j) {
+        _y[j] = hsum128(_mm_add_ps(_mm256_castps256_ps128(acc[j]), _mm256_extractf128_ps(acc[j], 1)))
+                + dotScalar(_w + j * _stride + i, _x + i, _size - i);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void gemvRowAvx2(const float *_w, std::size_t, const float *_x, std::size_t _size, float *_y) noexcept {
+    *_y = dotAvx2(_w, _x, _size);
+}
+
+__attribute__((target("avx2,fma")))
+static void scaleAvx2(float *_dst, std::size_t _size, float _factor) noexcept {
+    auto factor = _mm256_set1_ps(_factor);
+    std::size_t i = 0;
+    for (; i + 8 <= _size; i += 8) {
+        _mm256_storeu_ps(_dst + i, _mm256_mul_ps(_mm256_loadu_ps(_dst + i), factor));
+    }
+    for (; i < _size; ++i) {
+        _dst[i] *= _factor;
+    }
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void accumulateFp16Avx2(float *_dst, const uint16_t *_src, std::size_t _size) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= _size; i += 8) {
+        auto values = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + i)));
+        _mm256_storeu_ps(_dst + i, _mm256_add_ps(_mm256_loadu_ps(_dst + i), values));
+    }
+    accumulateFp16Scalar(_dst + i, _src + i, _size - i);
+}
+
+__attribute__((target("avx2,fma")))
+static void accumulateInt8Avx2(float *_dst, const int8_t *_src, float _scale, std::size_t _size) noexcept {
+    auto scale = _mm256_set1_ps(_scale);
+    std::size_t i = 0;
+    for (; i + 8 <= _size; i += 8) {
+        auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(_src + i));
+        auto values = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes));
+        _mm256_storeu_ps(_dst + i, _mm256_fmadd_ps(values, scale, _mm256_loadu_ps(_dst + i)));
+    }
+    accumulateInt8Scalar(_dst + i, _src + i, _scale, _size - i);
+}
+
+// tails are processed by masked loads and stores
+__attribute__((target("avx512f")))
+static inline __mmask16 tailMask(std::size_t _rest) noexcept {
+    return static_cast<__mmask16>((1u << _rest) - 1);
+}
+
+__attribute__((target("avx512f")))
+static void accumulateAvx512(float *_dst, const float *_src, std::size_t _size) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        _mm512_storeu_ps(_dst + i, _mm512_add_ps(_mm512_loadu_ps(_dst + i), _mm512_loadu_ps(_src + i)));
+    }
+    if (i < _size) {
+        auto mask = tailMask(_size - i);
+        _mm512_mask_storeu_ps(_dst + i, mask, _mm512_add_ps(_mm512_maskz_loadu_ps(mask, _dst + i),
+                                                              _mm512_maskz_loadu_ps(mask, _src + i)));
+    }
+}
+
+__attribute__((target("avx512f")))
+static float dotAvx512(const float *_l, const float *_r, std::size_t _size) noexcept {
+    auto acc0 = _mm512_setzero_ps();
+    auto acc1 = _mm512_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 32 <= _size; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(_l + i), _mm512_loadu_ps(_r + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(_l + i + 16), _mm512_loadu_ps(_r + i + 16), acc1);
+    }
+    for (; i + 16 <= _size; i += 16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(_l + i), _mm512_loadu_ps(_r + i), acc0);
+    }
+    if (i < _size) {
+        auto mask = tailMask(_size - i);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, _l + i), _mm512_maskz_loadu_ps(mask, _r + i), acc1);
+    }
+    // lanes are summed in memory, the reduction intrinsics trigger false -Wuninitialized in GCC 12
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, _mm512_add_ps(acc0, acc1));
+    return hsum128(_mm_add_ps(_mm_add_ps(_mm_load_ps(lanes), _mm_load_ps(lanes + 4)),
+                              _mm_add_ps(_mm_load_ps(lanes + 8), _mm_load_ps(lanes + 12))));
+}
+
+__attribute__((target("avx512f")))
+static float sumOfSquaresAvx512(const float *_src, std::size_t _size) noexcept {
+    return dotAvx512(_src, _src, _size);
+}
+
+template<std::size_t rows_t>
+__attribute__((target("avx512f")))
+static void gemvBlockAvx512(const float *_w, std::size_t _stride, const float *_x, std::size_t _size,
+                            float *_y) noexcept {
+    __m512 acc[rows_t];
+#pragma GCC unroll 9
+    for (std::size_t j = 0; j < rows_t; ++j) {
+        acc[j] = _mm512_setzero_ps();
+    }
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        auto x = _mm512_loadu_ps(_x + i);
+#pragma GCC unroll 9
+        for (std::size_t j = 0; j < rows_t; ++j) {
+            acc[j] = _mm512_fmadd_ps(_mm512_loadu_ps(_w + j * _stride + i), x, acc[j]);
+        }
+    }
+    if (i < _size) {
+        auto mask = tailMask(_size - i);
+        auto x = _mm512_maskz_loadu_ps(mask, _x + i);
+#pragma GCC unroll 9
+        for (std::size_t j = 0; j < rows_t; ++j) {
+            acc[j] = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, _w + j * _stride + i), x, acc[j]);
+        }
+    }
+    alignas(64) float lanes[16];
+    for (std::size_t j = 0; j < rows_t; ++j) {
+        _mm512_store_ps(lanes, acc[j]);
+        _y[j] = hsum128(_mm_add_ps(_mm_add_ps(_mm_load_ps(lanes), _mm_load_ps(lanes + 4)),
+                                   _mm_add_ps(_mm_load_ps(lanes + 8), _mm_load_ps(lanes + 12))));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void gemvRowAvx512(const float *_w, std::size_t, const float *_x, std::size_t _size, float *_y) noexcept {
+    *_y = dotAvx512(_w, _x, _size);
+}
+
+__attribute__((target("avx512f")))
+static void scaleAvx512(float *_dst, std::size_t _size, float _factor) noexcept {
+    auto factor = _mm512_set1_ps(_factor);
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        _mm512_storeu_ps(_dst + i, _mm512_mul_ps(_mm512_loadu_ps(_dst + i), factor));
+    }
+    if (i < _size) {
+        auto mask = tailMask(_size - i);
+        _mm512_mask_storeu_ps(_dst + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, _dst + i), factor));
+    }
+}
+
+// conversions are zero masked, the unmasked intrinsics trigger false -Wmaybe-uninitialized in GCC 12
+static const __mmask16 fullMask = 0xffff;
+
+__attribute__((target("avx512f")))
+static void accumulateFp16Avx512(float *_dst, const uint16_t *_src, std::size_t _size) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        auto values = _mm512_maskz_cvtph_ps(fullMask, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_src + i)));
+        _mm512_storeu_ps(_dst + i, _mm512_add_ps(_mm512_loadu_ps(_dst + i), values));
+    }
+    accumulateFp16Scalar(_dst + i, _src + i, _size - i);
+}
+
+__attribute__((target("avx512f")))
+static void accumulateInt8Avx512(float *_dst, const int8_t *_src, float _scale, std::size_t _size) noexcept {
+    auto scale = _mm512_set1_ps(_scale);
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + i));
+        auto values = _mm512_maskz_cvtepi32_ps(fullMask, _mm512_maskz_cvtepi8_epi32(fullMask, bytes));
+        _mm512_storeu_ps(_dst + i, _mm512_fmadd_ps(values, scale, _mm512_loadu_ps(_dst + i)));
+    }
+    accumulateInt8Scalar(_dst + i, _src + i, _scale, _size - i);
+}
+#endif
+
+static kernels_t kernels(vecMath_t::isa_t _isa) noexcept {
+    switch (_isa) {
+#ifdef TGNEWS_VECMATH_X86
+        case vecMath_t::isa_t::AVX512:
+            return {_isa, accumulateAvx512, sumOfSquaresAvx512, dotAvx512, scaleAvx512,
+                    accumulateFp16Avx512, accumulateInt8Avx512,
+                    gemvBlocks<gemvBlockAvx512<9>, gemvBlockAvx512<4>, gemvRowAvx512>};
+        case vecMath_t::isa_t::AVX2:
+            return {_isa, accumulateAvx2, sumOfSquaresAvx2, dotAvx2, scaleAvx2,
+                    accumulateFp16Avx2, accumulateInt8Avx2,
+                    gemvBlocks<gemvBlockAvx2<9>, gemvBlockAvx2<4>, gemvRowAvx2>};
+        case vecMath_t::isa_t::SSE2:
+            // SSE2 has no half precision conversions
+            return {_isa, accumulateSse2, sumOfSquaresSse2, dotSse2, scaleSse2,
+                    accumulateFp16Scalar, accumulateInt8Sse2,
+                    gemvBlocks<gemvBlockSse2<9>, gemvBlockSse2<4>, gemvRowSse2>};
+#endif
+        default:
+            return {vecMath_t::isa_t::SCALAR, accumulateScalar, sumOfSquaresScalar, dotScalar, scaleScalar,
+                    accumulateFp16Scalar, accumulateInt8Scalar, gemvScalar};
+    }
+}
+
+static kernels_t g_kernels = kernels(vecMath_t::supported());
+
+void vecMath_t::accumulate(float *_dst, const float *_src, std::size_t _size) noexcept {
+    g_kernels.accumulate(_dst, _src, _size);
+}
+
+float vecMath_t::sumOfSquares(const float *_src, std::size_t _size) noexcept {
+    return g_kernels.sumOfSquares(_src, _size);
+}
+
+float vecMath_t::dot(const float *_l, const float *_r, std::size_t _size) noexcept {
+    return g_kernels.dot(_l, _r, _size);
+}
+
+void vecMath_t::scale(float *_dst, std::size_t _size, float _factor) noexcept {
+    g_kernels.scale(_dst, _size, _factor);
+}
+
+void vecMath_t::accumulateFp16(float *_dst, const uint16_t *_src, std::size_t _size) noexcept {
+    g_kernels.accumulateFp16(_dst, _src, _size);
+}
+
+void vecMath_t::accumulateInt8(float *_dst, const int8_t *_src, float _scale, std::size_t _size) noexcept {
+    g_kernels.accumulateInt8(_dst, _src, _scale, _size);
+}
+
+void vecMath_t::gemv(const float *_w, std::size_t _stride, std::size_t _rows,
+                     const float *_x, std::size_t _size, float *_y) noexcept {
+    g_kernels.gemv(_w, _stride, _rows, _x, _size, _y);
+}
+
+uint16_t vecMath_t::toFp16(float _value) noexcept {
+    uint32_t x;
+    std::memcpy(&x, &_value, sizeof(x));
+    auto sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+    x &= 0x7fffffff;
+
+    if (x >= 0x7f800000) {
+        // infinity or NaN (quiet)
+        return sign | ((x > 0x7f800000)?0x7e00:0x7c00);
+    }
+    if (x >= 0x477ff000) {
+        // rounds to infinity
+        return sign | 0x7c00;
+    }
+    if (x < 0x38800000) {
+        // subnormal, the FPU rounds the mantissa when it is added to 0.5 (2^-1 + 2^-24 ulp)
+        float value;
+        std::memcpy(&value, &x, sizeof(value));
+        value += 0.5f;
+        std::memcpy(&x, &value, sizeof(x));
+        return sign | static_cast<uint16_t>(x - 0x3f000000);
+    }
+    // rebias the exponent and round the mantissa to nearest even
+    x += 0xc8000fff + ((x >> 13) & 1);
+    return sign | static_cast<uint16_t>(x >> 13);
+}
+
+float vecMath_t::fromFp16(uint16_t _value) noexcept {
+    uint32_t sign = static_cast<uint32_t>(_value & 0x8000) << 16;
+    uint32_t exponent = (_value >> 10) & 0x1f;
+    uint32_t mantissa = _value & 0x3ff;
+
+    uint32_t x;
+    if (exponent == 0x1f) {
+        x = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        x = sign;
+    } else {
+        // subnormal, normalized to float
+        exponent = 113;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        x = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+
+    float ret;
+    std::memcpy(&ret, &x, sizeof(ret));
+    return ret;
+}
+
+vecMath_t::isa_t vecMath_t::supported() noexcept {
+#ifdef TGNEWS_VECMATH_X86
+    // OS support of the extended registers is checked as well
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return isa_t::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c")) {
+        return isa_t::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return isa_t::SSE2;
+    }
+#endif
+    return isa_t::SCALAR;
+}
+
+vecMath_t::isa_t vecMath_t::isa() noexcept {
+    return g_kernels.isa;
+}
+
+vecMath_t::isa_t vecMath_t::isa(isa_t _isa) noexcept {
+    auto supportedIsa = supported();
+    g_kernels = kernels((static_cast<int>(_isa) <= static_cast<int>(supportedIsa))?_isa:supportedIsa);
+    return g_kernels.isa;
+}
+
+const char *vecMath_t::name(isa_t _isa) noexcept {
+    switch (_isa) {
+        case isa_t::SSE2:
+            return "SSE2";
+        case isa_t::AVX2:
+            return "AVX2";
+        case isa_t::AVX512:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * @file vecMath/vecMath.h
+ * @brief
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#ifndef TGNEWS_VECMATH_H
+#define TGNEWS_VECMATH_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Float vector kernels used by embedding and clustering. SSE2, AVX2 (with FMA and F16C) and AVX-512 implementations
+// are selected at runtime by the CPU features, other architectures use the scalar ones.
+class vecMath_t final {
+public:
+    enum class isa_t {
+        SCALAR,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    vecMath_t() = delete;
+
+    // _dst[i] += _src[i]
+    static void accumulate(float *_dst, const float *_src, std::size_t _size) noexcept;
+    // sum of _src[i] * _src[i]
+    static float sumOfSquares(const float *_src, std::size_t _size) noexcept;
+    // sum of _l[i] * _r[i]
+    static float dot(const float *_l, const float *_r, std::size_t _size) noexcept;
+    // _dst[i] *= _factor
+    static void scale(float *_dst, std::size_t _size, float _factor) noexcept;
+    // _dst[i] += _src[i], _src is IEEE 754 half precision
+    static void accumulateFp16(float *_dst, const uint16_t *_src, std::size_t _size) noexcept;
+    // _dst[i] += _src[i] * _scale
+    static void accumulateInt8(float *_dst, const int8_t *_src, float _scale, std::size_t _size) noexcept;
+    // _y[j] = sum of _w[j * _stride + i] * _x[i], j = [0, _rows), rows are evaluated in blocks by one pass over _x
+    static void gemv(const float *_w, std::size_t _stride, std::size_t _rows,
+                     const float *_x, std::size_t _size, float *_y) noexcept;
+
+    // half precision conversions, round to nearest even
+    [[nodiscard]] static uint16_t toFp16(float _value) noexcept;
+    [[nodiscard]] static float fromFp16(uint16_t _value) noexcept;
+
+    // the best ISA supported by the CPU
+    [[nodiscard]] static isa_t supported() noexcept;
+    [[nodiscard]] static isa_t isa() noexcept;
+    // selects kernels of the _isa level (benchmarks), falls back to the supported one; not thread safe
+    static isa_t isa(isa_t _isa) noexcept;
+    [[nodiscard]] static const char *name(isa_t _isa) noexcept;
+};
+
+#endif //TGNEWS_VECMATH_H
@@ -0,0 +1,94 @@
+/**
+ * @file vecMath/vecMathBench.cpp
+ * @brief vecMath_t kernels throughput per ISA level
+ * @author agent
+ * @date 17.10.2026
+*/
+
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+#include "vecMath.h"
+
+// runs _kernel until _seconds elapsed, returns GFLOP/s
+template<typename kernel_t>
+static double measure(const kernel_t &_kernel, std::size_t _flops, double _seconds) {
+    std::size_t calls = 0;
+    auto started = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < _seconds) {
+        for (int i = 0; i < 1000; ++i) {
+            _kernel();
+        }
+        calls += 1000;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    return static_cast<double>(calls) * static_cast<double>(_flops) / elapsed / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    // 512 - embedding vector size, larger sizes are bound by the cache bandwidth
+    std::vector<std::size_t> sizes{512};
+    for (int i = 1; i < argc; ++i) {
+        sizes.emplace_back(std::strtoul(argv[i], nullptr, 10));
+    }
+
+    std::cout << "supported: " << vecMath_t::name(vecMath_t::supported()) << std::endl;
+    std::cout << std::setw(8) << "ISA" << std::setw(8) << "size"
+              << std::setw(12) << "accumulate" << std::setw(14) << "sumOfSquares"
+              << std::setw(10) << "dot" << std::setw(10) << "scale" << std::setw(10) << "gemv9"
+              << "  GFLOP/s" << std::endl;
+
+    volatile float sink = 0.0f;
+    for (auto isa:{vecMath_t::isa_t::SCALAR, vecMath_t::isa_t::SSE2, vecMath_t::isa_t::AVX2,
+                   vecMath_t::isa_t::AVX512}) {
+        if (vecMath_t::isa(isa) != isa) {
+            continue;
+        }
+        for (auto size:sizes) {
+            std::vector<float> l(size);
+            std::vector<float> r(size);
+            // 9 rows - fused news, category and weight heads
+            std::vector<float> w(9 * size);
+            float y[9];
+            for (std::size_t i = 0; i < w.size(); ++i) {
+                w[i] = static_cast<float>(i % 3) * 0.125f;
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                l[i] = static_cast<float>(i % 7) * 0.25f;
+                r[i] = static_cast<float>(i % 5) * 0.5f;
+            }
+
+            auto accumulate = measure([&] {
+                vecMath_t::accumulate(l.data(), r.data(), size);
+            }, size, 0.5);
+            auto sumOfSquares = measure([&] {
+                sink = sink + vecMath_t::sumOfSquares(l.data(), size);
+            }, 2 * size, 0.5);
+            auto dot = measure([&] {
+                sink = sink + vecMath_t::dot(l.data(), r.data(), size);
+            }, 2 * size, 0.5);
+            // factors keep the values finite
+            bool even = false;
+            auto scale = measure([&] {
+                vecMath_t::scale(l.data(), size, (even = !even)?0.5f:2.0f);
+            }, size, 0.5);
+            auto gemv = measure([&] {
+                vecMath_t::gemv(w.data(), size, 9, r.data(), size, y);
+                sink = sink + y[8];
+            }, 2 * 9 * size, 0.5);
+
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(8) << vecMath_t::name(isa) << std::setw(8) << size
+                      << std::setw(12) << accumulate << std::setw(14) << sumOfSquares
+                      << std::setw(10) << dot << std::setw(10) << scale << std::setw(10) << gemv << std::endl;
+        }
+    }
+    vecMath_t::isa(vecMath_t::supported());
+
+    return EXIT_SUCCESS;
+}